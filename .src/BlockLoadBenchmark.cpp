@@ -0,0 +1,274 @@
+#include "ThreadPool.h"
+#include "LoadBalanceStrategy.h"
+#include "Logger.h"
+#include "BlockJsonLoader.h"
+#include "BlockBakedCache.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Block JSON startup benchmark.
+//
+// Loads the block states, definitions and models with 1, 2, 4, ... loader
+// threads and reports wall time and speedup against the single-threaded run,
+// then the same data from the baked binary cache (BlockBakedCache).
+// Without --data a synthetic resource pack is generated in a temp folder.
+//
+// Usage: BlockLoadBenchmark [--data <folder with block_states/ block_definitions/ block_models/>]
+//                           [--blocks N] [--reps R] [--out report.json]
+
+using Clock = std::chrono::steady_clock;
+using nlohmann::json;
+namespace fs = std::filesystem;
+
+namespace
+{
+    struct BenchOptions
+    {
+        std::string dataRoot;
+        size_t blocks = 4000;
+        int reps = 5;
+        std::string outPath;
+    };
+
+    struct PackFolders
+    {
+        fs::path states;
+        fs::path definitions;
+        fs::path models;
+    };
+
+    BenchOptions ParseArgs(int argc, char** argv)
+    {
+        BenchOptions o;
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            if (std::strcmp(argv[i], "--data") == 0)
+                o.dataRoot = argv[i + 1];
+            else if (std::strcmp(argv[i], "--blocks") == 0)
+                o.blocks = std::stoull(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--reps") == 0)
+                o.reps = std::max(1, std::stoi(argv[i + 1])); // the median needs a sample
+            else if (std::strcmp(argv[i], "--out") == 0)
+                o.outPath = argv[i + 1];
+        }
+        return o;
+    }
+
+    void WriteFile(const fs::path& path, const json& j)
+    {
+        std::ofstream out(path);
+        out << j.dump(2);
+    }
+
+    // Writes `blocks` blocks with a state, a definition and two models each.
+    // Models are Blockbench-style with a few elements, close to real files in size.
+    PackFolders GeneratePack(const fs::path& root, size_t blocks)
+    {
+        PackFolders f{root / "block_states", root / "block_definitions", root / "block_models"};
+        fs::remove_all(root);
+        fs::create_directories(f.states);
+        fs::create_directories(f.definitions);
+        fs::create_directories(f.models);
+
+        for (size_t i = 0; i < blocks; ++i)
+        {
+            const std::string name = "block" + std::to_string(i);
+
+            WriteFile(f.states / (name + ".json"), {
+                {"properties", {{"wet", "false"}, {"facing", "north"}}},
+                {"variants", {{"wet=false", "block/" + name + "_dry"}, {"wet=true", "block/" + name + "_wet"}}},
+            });
+
+            WriteFile(f.definitions / (name + ".json"), {
+                {"isTransparent", false}, {"isSolid", true}, {"isOpaque", true}, {"isFullCube", true},
+            });
+
+            for (const char* variant : {"dry", "wet"})
+            {
+                json elements = json::array();
+                for (int e = 0; e < 6; ++e)
+                {
+                    json faces = json::object();
+                    for (const char* face : {"north", "east", "south", "west", "up", "down"})
+                        faces[face] = {{"uv", {0, 0, 16, 16}}, {"texture", "#0"}};
+
+                    elements.push_back({
+                        {"from", {0, e, 0}},
+                        {"to", {16, e + 1, 16}},
+                        {"rotation", {{"angle", 0}, {"axis", "y"}, {"origin", {8, 8, 8}}}},
+                        {"faces", faces},
+                    });
+                }
+
+                WriteFile(f.models / (name + "_" + variant + ".json"), {
+                    {"credit", "BlockLoadBenchmark"},
+                    {"format_version", "1.21.6"},
+                    {"textures", {{"0", "block/" + name}}},
+                    {"elements", elements},
+                });
+            }
+        }
+        return f;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const BenchOptions opts = ParseArgs(argc, argv);
+
+    // Per-file errors still reach the console; the load summaries do not.
+    Logger& logger = Logger::Instance();
+    logger.SetLogLevel(LogLevel::Warning);
+
+    PackFolders folders;
+    fs::path generated;
+    if (opts.dataRoot.empty())
+    {
+        generated = fs::temp_directory_path() / "BlockLoadBenchmark";
+        std::cerr << "[bench] Generating " << opts.blocks << " blocks in " << generated.string() << "\n";
+        folders = GeneratePack(generated, opts.blocks);
+    }
+    else
+    {
+        const fs::path root(opts.dataRoot);
+        folders = {root / "block_states", root / "block_definitions", root / "block_models"};
+    }
+
+    ThreadPool& pool = ThreadPool::Instance();
+    pool.SetStrategy(std::make_unique<LoadBalanceStrategy>());
+    pool.Init();
+
+    const size_t maxThreads = pool.GetWorkers().size() + 1;
+    std::vector<size_t> threadCounts;
+    for (size_t t = 1; t < maxThreads; t *= 2)
+        threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    json report;
+    report["meta"] = {
+        {"hardware_concurrency", std::thread::hardware_concurrency()},
+        {"pool_workers", pool.GetWorkers().size()},
+        {"reps", opts.reps},
+        {"data", opts.dataRoot.empty() ? "generated" : opts.dataRoot},
+        {"unix_time", static_cast<int64_t>(std::time(nullptr))},
+    };
+    report["results"] = json::array();
+
+    double baselineMs = 0.0;
+
+    std::cout << "threads  files  blocks   wall_ms  parse_ms  merge_ms  speedup\n";
+
+    for (size_t threads : threadCounts)
+    {
+        BlockJsonDataCacheConfig config;
+        config.parallel = threads > 1;
+        config.maxParallelism = threads;
+        config.taskType = TaskType::Heavy;
+
+        BlockJsonLoader loader(logger, config);
+
+        // Warm-up: fills the OS file cache so every row measures parsing, not the disk.
+        loader.LoadAll(folders.states, folders.definitions, folders.models);
+
+        std::vector<double> wall;
+        BlockJsonLoadStats stats;
+        for (int rep = 0; rep < opts.reps; ++rep)
+        {
+            const auto start = Clock::now();
+            auto blocks = loader.LoadAll(folders.states, folders.definitions, folders.models);
+            wall.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            stats = loader.GetLastStats();
+        }
+
+        std::sort(wall.begin(), wall.end());
+        const double medianMs = wall[wall.size() / 2];
+        if (threads == 1)
+            baselineMs = medianMs;
+        const double speedup = medianMs > 0.0 ? baselineMs / medianMs : 0.0;
+
+        std::printf("%7zu  %5zu  %6zu  %8.1f  %8.1f  %8.1f  %6.2fx\n",
+                    stats.shards, stats.files, stats.blocks, medianMs, stats.parseMs, stats.mergeMs, speedup);
+
+        report["results"].push_back({
+            {"threads", stats.shards},
+            {"files", stats.files},
+            {"blocks", stats.blocks},
+            {"wall_ms_median", medianMs},
+            {"wall_ms_min", wall.front()},
+            {"wall_ms_max", wall.back()},
+            {"parse_ms", stats.parseMs},
+            {"merge_ms", stats.mergeMs},
+            {"speedup", speedup},
+        });
+    }
+
+    // Baked cache: the warm start path when no JSON file changed.
+    {
+        const BlockJsonFolders sources{folders.states, folders.definitions, folders.models};
+        const fs::path bakePath = fs::temp_directory_path() / "BlockLoadBenchmark.bake";
+
+        BlockJsonDataCacheConfig config;
+        config.parallel = true;
+        BlockJsonLoader loader(logger, config);
+        BlockBakedCache baked(logger);
+        baked.Save(bakePath, BlockBakedCache::BuildManifest(sources),
+                   loader.LoadAll(folders.states, folders.definitions, folders.models));
+
+        std::vector<double> wall;
+        size_t blocks = 0;
+        for (int rep = 0; rep < opts.reps; ++rep)
+        {
+            std::unordered_map<std::string, BlockJsonData> out;
+            const auto start = Clock::now();
+            const bool hit = baked.TryLoad(bakePath, sources, out);
+            wall.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            blocks = hit ? out.size() : 0;
+        }
+
+        std::sort(wall.begin(), wall.end());
+        const double medianMs = wall[wall.size() / 2];
+        const double speedup = medianMs > 0.0 ? baselineMs / medianMs : 0.0;
+        const uintmax_t bakeBytes = fs::file_size(bakePath);
+
+        std::printf("  baked      -  %6zu  %8.1f         -         -  %6.2fx  (%ju KB)\n",
+                    blocks, medianMs, speedup, bakeBytes / 1024);
+
+        report["baked"] = {
+            {"blocks", blocks},
+            {"bytes", bakeBytes},
+            {"wall_ms_median", medianMs},
+            {"wall_ms_min", wall.front()},
+            {"wall_ms_max", wall.back()},
+            {"speedup", speedup},
+        };
+
+        fs::remove(bakePath);
+    }
+
+    pool.Shutdown();
+
+    if (!generated.empty())
+        fs::remove_all(generated);
+
+    if (!opts.outPath.empty())
+    {
+        std::ofstream out(opts.outPath);
+        out << report.dump(2) << std::endl;
+        std::cerr << "[bench] Report written to " << opts.outPath << "\n";
+    }
+
+    return 0;
+}
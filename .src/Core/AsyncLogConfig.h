@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @brief What a logging call does when the async queue is full.
+ */
+enum class LogOverflowPolicy {
+    Block,      ///< Wait for the backend to make room (no loss).
+    DropOldest, ///< Evict the oldest queued record to make room.
+    DropNewest  ///< Discard the record being logged.
+};
+
+/**
+ * @brief Settings for Logger's asynchronous mode.
+ *
+ * Callers push records into a bounded lock-free queue; one backend thread
+ * formats and writes them in batches.
+ */
+struct AsyncLogConfig {
+    /// Queue capacity in records (rounded up to a power of two).
+    size_t queueCapacity = 8192;
+
+    /// Maximum time a written record may sit in stream buffers before a flush.
+    std::chrono::milliseconds flushInterval{200};
+
+    /// Flush as soon as this many records were written since the last flush.
+    size_t flushBatchSize = 512;
+
+    /// Flush immediately after writing an Error or Critical record.
+    bool flushOnError = true;
+
+    /// Behaviour when the queue is full.
+    LogOverflowPolicy overflow = LogOverflowPolicy::Block;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief CRC-32 (IEEE 802.3, as used by gzip and zip).
+ *
+ * @p crc continues a previous result, so data can be hashed in pieces:
+ * @code
+ * uint32_t c = Crc32(a, aSize);
+ * c = Crc32(b, bSize, c);
+ * @endcode
+ */
+inline uint32_t Crc32(const void* data, size_t size, uint32_t crc = 0) noexcept {
+    static constexpr std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t {};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    const auto* p = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+        crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
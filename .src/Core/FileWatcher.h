@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Watches directories (not recursively) for file changes.
+ *
+ * Uses inotify on Linux and ReadDirectoryChangesW on Windows; elsewhere
+ * Start() returns false. Events are collected on a background thread and
+ * debounced: editors write a file in several steps (truncate, write, rename),
+ * so a path is reported once after it has been quiet for @c debounce.
+ *
+ * @code
+ * FileWatcher watcher;
+ * watcher.Start({modelsFolder}, [](const std::vector<FileWatcher::Change>& changes) {
+ *     for (const auto& c : changes) Reload(c.path);
+ * });
+ * @endcode
+ */
+class FileWatcher {
+public:
+    enum class ChangeKind {
+        Modified, ///< Created, written or renamed into the folder.
+        Removed   ///< Deleted or renamed out of the folder.
+    };
+
+    struct Change {
+        std::filesystem::path path;
+        ChangeKind kind;
+    };
+
+    /** @brief Receives one debounced batch, on the watcher thread. */
+    using Callback = std::function<void(const std::vector<Change>&)>;
+
+    FileWatcher() = default;
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * @brief Starts watching @p folders, stopping any previous watch.
+     * @return false if the platform is unsupported or no folder could be watched.
+     */
+    bool Start(const std::vector<std::filesystem::path>& folders,
+               Callback callback,
+               std::chrono::milliseconds debounce = std::chrono::milliseconds(150));
+
+    /** @brief Stops the watcher thread; pending changes are dropped. */
+    void Stop();
+
+    bool IsRunning() const noexcept { return m_running.load(std::memory_order_relaxed); }
+
+private:
+    struct Pending {
+        std::filesystem::path path;
+        ChangeKind kind;
+        std::chrono::steady_clock::time_point last;
+    };
+
+    void Run();
+    void Record(const std::filesystem::path& path, ChangeKind kind);
+    void EmitQuiet();
+
+    std::vector<std::filesystem::path> m_folders;
+    Callback m_callback;
+    std::chrono::milliseconds m_debounce{150};
+    std::vector<Pending> m_pending;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_stop{false};
+
+#ifdef _WIN32
+    std::vector<void*> m_handles; // directory HANDLEs, one per folder
+#else
+    int m_fd = -1;
+    std::vector<int> m_watches;   // inotify watch descriptors, one per folder
+#endif
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "LogLevel.h"
+#include "LogRecord.h"
+
+/** @brief Appends one formatted record (including the trailing '\n') to @p out. */
+using LogFormatter = void (*)(std::string& out, const LogRecord& record);
+
+/**
+ * @brief One destination of log records (console, file, memory, ...).
+ *
+ * Logger only calls Write() for records at or above GetLevel(), so a sink
+ * that filters a record out never formats it. Output is batched: Write()
+ * formats into the sink's buffer, Commit() ends a batch (one record in
+ * synchronous mode, one backend batch in async mode), Flush() pushes device
+ * buffers to the OS. All three are called with Logger's output lock held.
+ */
+class ILogSink {
+public:
+    virtual ~ILogSink() = default;
+
+    virtual std::string_view GetName() const = 0;
+
+    virtual LogLevel GetLevel() const = 0;
+    virtual void SetLevel(LogLevel level) = 0;
+
+    virtual void SetFormatter(LogFormatter formatter) = 0;
+
+    virtual void Write(const LogRecord& record) = 0;
+    virtual void Commit() = 0;
+    virtual void Flush() = 0;
+};
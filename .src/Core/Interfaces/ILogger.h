@@ -2,21 +2,14 @@
 
 #include <string>
 #include <string_view>
+#include <format>
+#include <chrono>
+#include <initializer_list>
 
-enum class LogLevel {
-    Trace,
-    Debug,
-    Info,
-    Warning,
-    Error,
-    Critical
-};
-
-enum class LogOutput {
-    Console,
-    File,
-    Both
-};
+#include "LogLevel.h"
+#include "LogRecord.h"
+#include "LogRateLimit.h"
+#include "TimestampService.h"
 
 class ILogger {
 public:
@@ -34,11 +27,123 @@ public:
     virtual void SetLogLevel(LogLevel level) = 0;
     virtual LogLevel GetLogLevel() const = 0;
 
+    // Per-subsystem thresholds. A category follows SetLogLevel() until it is
+    // given its own level, and again after ResetCategoryLevel().
+    virtual void SetCategoryLevel(LogCategory category, LogLevel level) = 0;
+    virtual void ResetCategoryLevel(LogCategory category) = 0;
+    virtual LogLevel GetCategoryLevel(LogCategory category) const = 0;
+    virtual bool ShouldLog(LogCategory category, LogLevel level) const = 0;
+
     virtual void SetOutput(LogOutput output) = 0;
     virtual LogOutput GetOutput() const = 0;
 
     virtual void SetLogFile(const std::string& filePath) = 0;
-    virtual const std::string& GetLogFile() const = 0;
+    // Path of the current log file, copied: rotation may replace it at any time.
+    virtual std::string GetLogFile() const = 0;
+
+    virtual void CleanupOldLogs(const std::string& folderPath, size_t maxLogs = 10) = 0;
+
+    // Blocks until every message logged so far has reached its outputs,
+    // including the pending "repeated N times" counts of LOG_DEDUPED sites.
+    virtual void Flush() = 0;
+
+    // Hands over a record that already passed the level check.
+    virtual void Submit(LogRecord&& record) = 0;
+
+    /**
+     * @brief Logs with deferred formatting.
+     *
+     * The format string is checked at compile time; the arguments are copied
+     * as raw bytes into the record and only formatted by the logging backend.
+     * No heap allocation as long as the arguments fit in the record.
+     *
+     * @code
+     * logger.LogF(LogLevel::Info, "Loaded {} blocks in {} ms", count, ms);
+     * @endcode
+     */
+    template <typename... Args>
+    void LogF(LogLevel level, std::format_string<Args...> fmt, Args&&... args) {
+        if (level < GetLogLevel())
+            return;
+
+        LogRecord record;
+        record.level = level;
+        record.thread = CurrentLogThreadId();
+        record.time = TimestampService::Now();
+        record.SetDeferred(fmt.get(), args...);
+        Submit(std::move(record));
+    }
+
+    /** @brief Same as LogF(level, ...), filtered by the level of @p category. */
+    template <typename... Args>
+    void LogF(LogCategory category, LogLevel level, std::format_string<Args...> fmt, Args&&... args) {
+        if (!ShouldLog(category, level))
+            return;
+
+        LogRecord record;
+        record.level = level;
+        record.category = category;
+        record.thread = CurrentLogThreadId();
+        record.time = TimestampService::Now();
+        record.SetDeferred(fmt.get(), args...);
+        Submit(std::move(record));
+    }
+
+    /**
+     * @brief LogF() that drops copies of the previous message of @p site.
+     *
+     * Used by @c LOG_DEDUPED; the fingerprint is taken from the packed
+     * arguments, so dropped copies are never formatted. Copies dropped at the
+     * end of a burst are reported once the window ends (async mode) or at Flush().
+     */
+    template <typename... Args>
+    void LogDeduped(LogSiteDedup& site, int64_t windowMs, LogCategory category, LogLevel level,
+                    std::format_string<Args...> fmt, Args&&... args) {
+        if (!ShouldLog(category, level))
+            return;
+
+        LogRecord record;
+        record.SetDeferred(fmt.get(), args...);
+
+        uint32_t repeats = 0;
+        if (!site.Admit(record.Fingerprint(), windowMs, repeats)) {
+            site.Track(*this, category, level, windowMs);
+            return;
+        }
+
+        if (repeats > 0)
+            LogF(category, level, LOG_DEDUP_REPEATED_FORMAT, repeats);
+
+        record.level = level;
+        record.category = category;
+        record.thread = CurrentLogThreadId();
+        record.time = TimestampService::Now();
+        Submit(std::move(record));
+    }
+
+    /**
+     * @brief Logs a message with key/value fields.
+     *
+     * Text outputs print the message followed by "key=value" pairs; the
+     * structured sink writes the fields as JSON members.
+     *
+     * @code
+     * logger.LogStructured(LogCategory::Blocks, LogLevel::Info, "Block cache loaded",
+     *                      {{"blocks", count}, {"ms", elapsedMs}});
+     * @endcode
+     */
+    void LogStructured(LogCategory category, LogLevel level, std::string_view message,
+                       std::initializer_list<LogField> fields) {
+        if (!ShouldLog(category, level))
+            return;
 
-    virtual void CleanupOldLogs(const std::string& folderPath, size_t maxLogs = 10);
+        LogRecord record;
+        record.level = level;
+        record.category = category;
+        record.thread = CurrentLogThreadId();
+        record.time = TimestampService::Now();
+        record.message.assign(message);
+        record.fields.assign(fields.begin(), fields.end());
+        Submit(std::move(record));
+    }
 };
\ No newline at end of file
@@ -2,9 +2,20 @@
 
 #include <functional>
 
+#include "CancellationToken.h"
+#include "TaskType.h"
+
 struct ITask
 {
     virtual ~ITask() = default;
     virtual void SetErrorCallback(const std::function<void(const std::exception &)> &callback) = 0;
+    virtual void SetCancellationToken(CancellationToken token) = 0;
+    virtual bool IsCancelled() const noexcept = 0;
+
+    // Category the task was submitted to; used to attribute errors.
+    virtual void SetTaskType(TaskType type) = 0;
+
+    // Called instead of operator() when the task was cancelled before it started.
+    virtual void OnCancelled() = 0;
     virtual void operator()() = 0;
 };
\ No newline at end of file
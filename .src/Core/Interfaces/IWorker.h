@@ -3,6 +3,7 @@
 #include <memory>
 
 #include "WorkerStatus.h"
+#include "WorkerIdlePolicy.h"
 #include "AddTaskResult.h"
 
 struct ITask;
@@ -19,8 +20,11 @@ struct IWorker
     virtual AddTaskResult AddTask(std::unique_ptr<ITask> t) = 0;
 
     virtual void SetAffinityIndex(size_t idx) = 0;
+    virtual void SetIdlePolicy(WorkerIdlePolicy policy) = 0;
 
-    virtual size_t GetQueueSize();
+    virtual size_t GetQueueSize() = 0;
     virtual WorkerStatus GetStatus() const = 0;
+    // Tasks that actually ran; skipped cancelled tasks are only in GetCancelledTasks().
     virtual uint64_t GetExecutedTasks() const = 0;
+    virtual uint64_t GetCancelledTasks() const = 0;
 };
\ No newline at end of file
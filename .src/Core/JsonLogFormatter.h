@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "LogRecord.h"
+
+/**
+ * @brief Formats log records as JSON lines, straight into a caller-owned buffer.
+ *
+ * One object per record, no DOM and no allocation beyond growing @p out:
+ * @code
+ * {"ts":1760777714416390,"level":"INFO","thread":3,"category":"Blocks","msg":"Block cache loaded","fields":{"blocks":412}}
+ * @endcode
+ * @c ts is microseconds since the Unix epoch (UTC).
+ */
+class JsonLogFormatter {
+public:
+    /** @brief Appends @p record followed by '\n'. */
+    static void Append(std::string& out, const LogRecord& record);
+
+    /** @brief Appends @p text as a quoted, escaped JSON string. */
+    static void AppendString(std::string& out, std::string_view text);
+};
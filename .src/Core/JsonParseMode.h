@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string_view>
+
+/**
+ * @brief How @ref Options parses a JSON file into its configuration type.
+ */
+enum class JsonParseMode {
+    Dom, ///< Build an nlohmann::json tree, then convert it with `from_json`.
+    Sax  ///< Stream the text through @ref JsonSaxReader straight into the type.
+};
+
+/**
+ * @brief Selects the parse mode per configuration type.
+ *
+ * Defaults to @c Dom. A type opts into streaming by specializing this
+ * trait and @ref JsonSaxReader next to its `from_json`:
+ *
+ * @code
+ * template <> struct JsonSaxReader<MyConfig> { static MyConfig Parse(std::string_view text); };
+ * template <> struct JsonParseTraits<MyConfig> { static constexpr JsonParseMode mode = JsonParseMode::Sax; };
+ * @endcode
+ *
+ * Both specializations must be visible wherever @c Options<MyConfig> is used.
+ */
+template <typename T>
+struct JsonParseTraits {
+    static constexpr JsonParseMode mode = JsonParseMode::Dom;
+};
+
+/**
+ * @brief Streaming parser for @p T; only declared for types that support it.
+ *
+ * `Parse` must produce the same result as `json::parse(text).get<T>()` and
+ * throw on malformed input.
+ */
+template <typename T>
+struct JsonSaxReader;
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "LogRotationConfig.h"
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Background worker that compresses rotated log files and applies
+ *        the retention policy of a @ref LogRotationConfig.
+ *
+ * Logger hands over every file it closes; compression and deletion never
+ * run on a logging thread. Only files named @c log_*.txt and
+ * @c log_*.txt.gz are touched, and never the file that is currently open or one still queued.
+ */
+class LogArchiver {
+public:
+    LogArchiver(const std::filesystem::path& folder, const LogRotationConfig& config);
+
+    /** @brief Finishes the queued work and stops the thread. */
+    ~LogArchiver();
+
+    LogArchiver(const LogArchiver&) = delete;
+    LogArchiver& operator=(const LogArchiver&) = delete;
+
+    /** @brief Queues a closed log file for compression, followed by a retention pass. */
+    void Archive(const std::filesystem::path& file);
+
+    /** @brief Queues compression of leftover uncompressed logs and a retention pass. */
+    void Sweep();
+
+    /** @brief The file Logger is writing to; excluded from every pass. */
+    void SetActiveFile(const std::filesystem::path& file);
+
+    /**
+     * @brief Writes @p source as a gzip member to @p target.
+     * @return false if the file could not be read, compressed or written.
+     */
+    static bool GzipFile(const std::filesystem::path& source,
+                         const std::filesystem::path& target,
+                         int level);
+
+private:
+    void Run();
+    void Compress(const std::filesystem::path& file);
+    void CompressLeftovers();
+    void ApplyRetention();
+    bool IsActive(const std::filesystem::path& file);
+
+    static bool IsLogFile(const std::filesystem::path& file);
+
+    const std::filesystem::path m_folder;
+    const LogRotationConfig m_config;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::filesystem::path> m_pending; // empty path = sweep
+    std::filesystem::path m_active;
+    bool m_stop = false;
+    std::thread m_thread;
+};
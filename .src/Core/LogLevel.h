@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+
+enum class LogLevel {
+    Trace,
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Critical
+};
+
+inline const char* ToString(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace:    return "TRACE";
+        case LogLevel::Debug:    return "DEBUG";
+        case LogLevel::Info:     return "INFO";
+        case LogLevel::Warning:  return "WARN";
+        case LogLevel::Error:    return "ERROR";
+        case LogLevel::Critical: return "CRIT";
+        default:                 return "UNKNOWN";
+    }
+}
+
+enum class LogOutput {
+    Console,
+    File,
+    Both
+};
+
+// Subsystems that can be given their own log level (see ILogger::SetCategoryLevel).
+enum class LogCategory : unsigned char {
+    General,
+    ThreadSystem,
+    Blocks,
+    Json,
+    Window,
+    Count
+};
+
+inline constexpr size_t LOG_CATEGORY_COUNT = static_cast<size_t>(LogCategory::Count);
+
+inline const char* ToString(LogCategory category) {
+    switch (category) {
+        case LogCategory::General:      return "General";
+        case LogCategory::ThreadSystem: return "ThreadSystem";
+        case LogCategory::Blocks:       return "Blocks";
+        case LogCategory::Json:         return "Json";
+        case LogCategory::Window:       return "Window";
+        default:                        return "Unknown";
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "ILogger.h"
+#include "LogRateLimit.h"
+
+/**
+ * @file LogMacros.h
+ * @brief Logging macros with compile-time and per-category filtering.
+ *
+ * Calls below @c LOG_MIN_LEVEL are removed by the preprocessor: neither the
+ * call nor its arguments are compiled. Calls at or above it first check the
+ * category level (one relaxed load on @c Logger) and only then evaluate the
+ * arguments and build the record.
+ *
+ * @code
+ * LOG_DEBUG(logger, LogCategory::Blocks, "Loaded {} models for {}", count, name);
+ * LOG_INFO(*loggerPtr, LogCategory::Json, "Parsed {}", path.string());
+ * @endcode
+ *
+ * Override the minimum from the build, e.g. @c /DLOG_MIN_LEVEL=3 keeps only
+ * Warning and above.
+ *
+ * Statements that can fire in a loop over bad data use the throttled forms,
+ * which keep their state in a static per call site (see LogRateLimit.h):
+ *
+ * @code
+ * // At most 20 lines per second from this line, then "N messages suppressed".
+ * LOG_ERROR_RATE_LIMITED(logger, LogCategory::Json, 20, "Bad block {}", name);
+ * // Identical consecutive lines within a second collapse into "repeated N times".
+ * LOG_DEDUPED(logger, LogCategory::ThreadSystem, LogLevel::Error, "Task failed: {}", what);
+ * @endcode
+ */
+
+// 0 = Trace, 1 = Debug, 2 = Info, 3 = Warning, 4 = Error, 5 = Critical (see LogLevel).
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL 2
+#else
+#define LOG_MIN_LEVEL 0
+#endif
+#endif
+
+#define LOG_AT(logger, category, level, ...)                              \
+    do {                                                                  \
+        if ((logger).ShouldLog((category), (level)))                      \
+            (logger).LogF((category), (level), __VA_ARGS__);              \
+    } while (0)
+
+#if LOG_MIN_LEVEL <= 0
+#define LOG_TRACE(logger, category, ...) LOG_AT(logger, category, LogLevel::Trace, __VA_ARGS__)
+#else
+#define LOG_TRACE(logger, category, ...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 1
+#define LOG_DEBUG(logger, category, ...) LOG_AT(logger, category, LogLevel::Debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(logger, category, ...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 2
+#define LOG_INFO(logger, category, ...) LOG_AT(logger, category, LogLevel::Info, __VA_ARGS__)
+#else
+#define LOG_INFO(logger, category, ...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 3
+#define LOG_WARNING(logger, category, ...) LOG_AT(logger, category, LogLevel::Warning, __VA_ARGS__)
+#else
+#define LOG_WARNING(logger, category, ...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 4
+#define LOG_ERROR(logger, category, ...) LOG_AT(logger, category, LogLevel::Error, __VA_ARGS__)
+#else
+#define LOG_ERROR(logger, category, ...) ((void)0)
+#endif
+
+// Critical messages are never compiled out.
+#define LOG_CRITICAL(logger, category, ...) LOG_AT(logger, category, LogLevel::Critical, __VA_ARGS__)
+
+// Call-site throttling. The limiter is checked after the level test, so a
+// disabled category costs nothing extra; suppressed lines are never formatted.
+#define LOG_RATE_LIMITED(logger, category, level, perSecond, ...)                        \
+    do {                                                                                  \
+        static LogSiteRateLimit logSiteLimit_;                                            \
+        uint32_t logSuppressed_ = 0;                                                      \
+        if ((logger).ShouldLog((category), (level)) &&                                    \
+            logSiteLimit_.Admit((perSecond), logSuppressed_)) {                           \
+            if (logSuppressed_ > 0)                                                       \
+                (logger).LogF((category), (level), "({} messages suppressed at {}:{})",   \
+                              logSuppressed_, LogSiteFileName(__FILE__), __LINE__);       \
+            (logger).LogF((category), (level), __VA_ARGS__);                              \
+        }                                                                                 \
+    } while (0)
+
+// Window during which an identical message from the same site is coalesced.
+#ifndef LOG_DEDUP_WINDOW_MS
+#define LOG_DEDUP_WINDOW_MS 1000
+#endif
+
+// The level is an argument here, so LOG_MIN_LEVEL is tested in the statement;
+// with a constant level the compiler drops the call and its arguments.
+#define LOG_DEDUPED(logger, category, level, ...)                                         \
+    do {                                                                                  \
+        if (static_cast<int>(level) >= LOG_MIN_LEVEL) {                                   \
+            static LogSiteDedup logSiteDedup_;                                            \
+            (logger).LogDeduped(logSiteDedup_, LOG_DEDUP_WINDOW_MS, (category), (level),  \
+                                __VA_ARGS__);                                             \
+        }                                                                                 \
+    } while (0)
+
+#if LOG_MIN_LEVEL <= 3
+#define LOG_WARNING_RATE_LIMITED(logger, category, perSecond, ...) \
+    LOG_RATE_LIMITED(logger, category, LogLevel::Warning, perSecond, __VA_ARGS__)
+#else
+#define LOG_WARNING_RATE_LIMITED(logger, category, perSecond, ...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 4
+#define LOG_ERROR_RATE_LIMITED(logger, category, perSecond, ...) \
+    LOG_RATE_LIMITED(logger, category, LogLevel::Error, perSecond, __VA_ARGS__)
+#else
+#define LOG_ERROR_RATE_LIMITED(logger, category, perSecond, ...) ((void)0)
+#endif
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+#include "LogLevel.h"
+
+class ILogger;
+
+/**
+ * @file LogRateLimit.h
+ * @brief Per-call-site state for rate-limited and deduplicated log statements.
+ *
+ * Each @c LOG_*_RATE_LIMITED / @c LOG_DEDUPED call site owns one static
+ * instance of these structs (see LogMacros.h), so a noisy statement only
+ * throttles itself. All members are relaxed atomics: races between threads
+ * can let one extra line through or miscount by one, never block.
+ */
+
+/**
+ * @brief Lets at most @c perSecond messages per one-second window through a call site.
+ *
+ * Messages over the budget are counted, and the count is reported with the
+ * first message admitted in a later window.
+ */
+struct LogSiteRateLimit
+{
+    std::atomic<int64_t> windowEndMs{0};
+    std::atomic<uint32_t> admitted{0};
+    std::atomic<uint32_t> suppressed{0};
+
+    /**
+     * @brief Decides whether the current call may log.
+     * @param perSecond Window budget.
+     * @param[out] suppressedBefore Messages dropped since the previous window
+     *        (only set when the call is admitted).
+     */
+    bool Admit(uint32_t perSecond, uint32_t& suppressedBefore) noexcept
+    {
+        const int64_t now = NowMs();
+        int64_t end = windowEndMs.load(std::memory_order_relaxed);
+
+        if (now >= end) {
+            // Only the thread that moves the window resets the counters.
+            if (windowEndMs.compare_exchange_strong(end, now + 1000, std::memory_order_relaxed)) {
+                admitted.store(0, std::memory_order_relaxed);
+                suppressedBefore = suppressed.exchange(0, std::memory_order_relaxed);
+            }
+        }
+
+        if (admitted.fetch_add(1, std::memory_order_relaxed) < perSecond)
+            return true;
+
+        suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    static int64_t NowMs() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+/**
+ * @brief Coalesces identical consecutive messages of a call site.
+ *
+ * A message equal to the previous one (same format string and arguments)
+ * logged within @c windowMs is dropped and counted; the next message that
+ * differs, or the same one after the window, reports "repeated N times".
+ * A site that drops copies is also listed (see TakePending()), so the count
+ * still reaches the log when no further message comes from it.
+ */
+struct LogSiteDedup
+{
+    std::atomic<uint64_t> lastFingerprint{0};
+    std::atomic<int64_t> lastEmitMs{0};
+    std::atomic<uint32_t> repeats{0};
+
+    // Set once by Track(), before the site is published in Sites().
+    std::atomic<bool> listed{false};
+    const ILogger* logger = nullptr;
+    LogCategory category = LogCategory::General;
+    LogLevel level = LogLevel::Info;
+    int64_t windowMs = 0;
+    LogSiteDedup* next = nullptr;
+
+    /**
+     * @param fingerprint LogRecord::Fingerprint() of the new message.
+     * @param windowMs How long an identical message stays suppressed.
+     * @param[out] repeatsBefore Copies of the previous message dropped (only set when admitted).
+     */
+    bool Admit(uint64_t fingerprint, int64_t windowMs, uint32_t& repeatsBefore) noexcept
+    {
+        const int64_t now = LogSiteRateLimit::NowMs();
+
+        if (fingerprint == lastFingerprint.load(std::memory_order_relaxed) &&
+            now - lastEmitMs.load(std::memory_order_relaxed) < windowMs) {
+            repeats.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        lastFingerprint.store(fingerprint, std::memory_order_relaxed);
+        lastEmitMs.store(now, std::memory_order_relaxed);
+        repeatsBefore = repeats.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    /** @brief Lists the site after its first dropped copy; later calls are one relaxed load. */
+    void Track(const ILogger& owner, LogCategory siteCategory, LogLevel siteLevel, int64_t siteWindowMs) noexcept
+    {
+        if (listed.load(std::memory_order_relaxed) || listed.exchange(true, std::memory_order_relaxed))
+            return;
+
+        logger = &owner;
+        category = siteCategory;
+        level = siteLevel;
+        windowMs = siteWindowMs;
+
+        std::atomic<LogSiteDedup*>& head = Sites();
+        next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Takes the repeat counts of @p owner's sites that no later message will report.
+     *
+     * Calls @p fn(category, level, count) for every listed site with dropped
+     * copies whose window has ended, or for all of them with @p all.
+     */
+    template <typename Fn>
+    static void TakePending(const ILogger& owner, bool all, Fn&& fn)
+    {
+        const int64_t now = LogSiteRateLimit::NowMs();
+
+        for (LogSiteDedup* site = Sites().load(std::memory_order_acquire); site; site = site->next) {
+            if (site->logger != &owner || site->repeats.load(std::memory_order_relaxed) == 0)
+                continue;
+            if (!all && now - site->lastEmitMs.load(std::memory_order_relaxed) < site->windowMs)
+                continue;
+
+            // Admit() may have taken the count first; then it already reported it.
+            const uint32_t count = site->repeats.exchange(0, std::memory_order_relaxed);
+            if (count > 0)
+                fn(site->category, site->level, count);
+        }
+    }
+
+    /** @brief Sites that ever dropped a copy. Sites are statics and are never unlisted. */
+    static std::atomic<LogSiteDedup*>& Sites() noexcept
+    {
+        static std::atomic<LogSiteDedup*> head{nullptr};
+        return head;
+    }
+};
+
+/// Line that reports the copies a LogSiteDedup dropped.
+inline constexpr std::string_view LOG_DEDUP_REPEATED_FORMAT = "(previous message repeated {} more times)";
+
+/// Strips the directory from @c __FILE__ for "suppressed at file:line" notes.
+constexpr std::string_view LogSiteFileName(std::string_view path) noexcept
+{
+    const size_t slash = path.find_last_of("/\\");
+    return slash == std::string_view::npos ? path : path.substr(slash + 1);
+}
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <atomic>
+
+#include "LogLevel.h"
+
+/** @brief Bytes reserved in every record for deferred-format arguments. */
+constexpr size_t LOG_ARGS_CAPACITY = 192;
+
+namespace LogArgs {
+
+    /// Strings are stored as a 16-bit length followed by the characters.
+    template <typename T>
+    concept StringLike =
+        std::is_convertible_v<const T&, std::string_view> &&
+        !std::is_arithmetic_v<std::remove_cvref_t<T>>;
+
+    /// Arithmetic values are stored as raw bytes.
+    template <typename T>
+    concept Scalar = std::is_arithmetic_v<std::remove_cvref_t<T>>;
+
+    /// The type an argument is decoded into on the backend.
+    template <typename T>
+    using Stored = std::conditional_t<StringLike<T>, std::string_view, std::remove_cvref_t<T>>;
+
+    template <typename T>
+    bool Encode(std::byte*& p, std::byte* end, const T& value) {
+        if constexpr (StringLike<T>) {
+            std::string_view sv(value);
+            const size_t room = static_cast<size_t>(end - p);
+            if (room < sizeof(uint16_t))
+                return false;
+            // Truncate long strings instead of falling back to the heap.
+            const uint16_t len = static_cast<uint16_t>(std::min<size_t>(sv.size(), room - sizeof(uint16_t)));
+            std::memcpy(p, &len, sizeof(len));
+            std::memcpy(p + sizeof(len), sv.data(), len);
+            p += sizeof(len) + len;
+            return len == sv.size();
+        } else {
+            static_assert(Scalar<T>, "LogF supports arithmetic and string arguments only");
+            if (static_cast<size_t>(end - p) < sizeof(T))
+                return false;
+            std::memcpy(p, &value, sizeof(T));
+            p += sizeof(T);
+            return true;
+        }
+    }
+
+    template <typename T>
+    Stored<T> Decode(const std::byte*& p) {
+        if constexpr (StringLike<T>) {
+            uint16_t len = 0;
+            std::memcpy(&len, p, sizeof(len));
+            const char* data = reinterpret_cast<const char*>(p + sizeof(len));
+            p += sizeof(len) + len;
+            return std::string_view(data, len);
+        } else {
+            Stored<T> value;
+            std::memcpy(&value, p, sizeof(value));
+            p += sizeof(value);
+            return value;
+        }
+    }
+
+    /// Rebuilds the arguments from the byte buffer and formats them into @p out.
+    template <typename... Args>
+    void DecodeAndFormat(std::string& out, std::string_view fmt, [[maybe_unused]] const std::byte* data) {
+        // Braced init guarantees left-to-right decoding.
+        std::tuple<Stored<Args>...> values{Decode<Args>(data)...};
+        std::apply([&](const auto&... v) {
+            std::vformat_to(std::back_inserter(out), fmt, std::make_format_args(v...));
+        }, values);
+    }
+
+} // namespace LogArgs
+
+/**
+ * @brief A key/value pair attached to a structured log record.
+ *
+ * Values keep their JSON type: integers, floating point, booleans and strings.
+ */
+struct LogField
+{
+    enum class Type : unsigned char { Int, UInt, Double, Bool, String };
+
+    std::string key;
+    Type type = Type::Int;
+    union {
+        int64_t i;
+        uint64_t u;
+        double d;
+        bool b;
+    };
+    std::string text;
+
+    template <typename T>
+    LogField(std::string_view name, const T& value) : key(name), i(0) {
+        if constexpr (std::is_same_v<T, bool>) {
+            type = Type::Bool;
+            b = value;
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            type = Type::Int;
+            i = value;
+        } else if constexpr (std::is_integral_v<T>) {
+            type = Type::UInt;
+            u = value;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            type = Type::Double;
+            d = value;
+        } else {
+            static_assert(LogArgs::StringLike<T>, "LogField supports arithmetic and string values only");
+            type = Type::String;
+            text.assign(std::string_view(value));
+        }
+    }
+};
+
+/** @brief Small sequential id of the calling thread (1, 2, 3, ...), stable for its lifetime. */
+inline uint32_t CurrentLogThreadId() noexcept {
+    static std::atomic<uint32_t> next{1};
+    thread_local const uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+/**
+ * @brief One log message as queued for the asynchronous backend.
+ *
+ * A record is either pre-formatted text (@c message, from Log()) or a format
+ * string plus raw argument bytes (from LogF()). Formatting (timestamp, level,
+ * colours and deferred arguments) happens on the backend thread, so the
+ * caller only pays for building this record.
+ */
+struct LogRecord
+{
+    using DecodeFn = void (*)(std::string& out, std::string_view fmt, const std::byte* data);
+
+    LogLevel level = LogLevel::Info;
+    LogCategory category = LogCategory::General;
+    uint32_t thread = 0;
+    std::chrono::system_clock::time_point time;
+
+    /// Pre-formatted message text (used when @c decode is null).
+    std::string message;
+
+    /// Deferred formatting: static format string, decoder and packed arguments.
+    std::string_view format;
+    DecodeFn decode = nullptr;
+    std::array<std::byte, LOG_ARGS_CAPACITY> args;
+    uint16_t argsSize = 0;
+
+    /// Key/value pairs for structured sinks (empty for plain messages).
+    std::vector<LogField> fields;
+
+    /**
+     * @brief Packs @p args for deferred formatting.
+     *
+     * Falls back to formatting immediately into @c message when the
+     * arguments do not fit into @c args.
+     */
+    template <typename... Args>
+    void SetDeferred(std::string_view fmt, const Args&... values) {
+        std::byte* p = args.data();
+        [[maybe_unused]] std::byte* end = args.data() + args.size(); // unused without arguments
+        const bool fits = (LogArgs::Encode(p, end, values) && ...);
+
+        if (fits) {
+            format = fmt;
+            decode = &LogArgs::DecodeAndFormat<Args...>;
+            argsSize = static_cast<uint16_t>(p - args.data());
+        } else {
+            message.clear();
+            std::vformat_to(std::back_inserter(message), fmt,
+                            std::make_format_args(values...));
+            decode = nullptr;
+        }
+    }
+
+    /**
+     * @brief Cheap identity of the message, used to coalesce repeats.
+     *
+     * Hashes the format string and packed argument bytes without formatting;
+     * eager messages hash their text.
+     */
+    uint64_t Fingerprint() const noexcept {
+        uint64_t h = 14695981039346656037ull; // FNV-1a
+        auto mix = [&h](const void* data, size_t size) {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i)
+                h = (h ^ bytes[i]) * 1099511628211ull;
+        };
+        if (decode) {
+            const void* fmtData = format.data();
+            mix(&fmtData, sizeof(fmtData));
+            mix(args.data(), argsSize);
+        } else {
+            mix(message.data(), message.size());
+        }
+        return h;
+    }
+
+    /// Formats deferred arguments into @c message once, so several sinks can share the text.
+    void Resolve() {
+        if (!decode)
+            return;
+        message.clear();
+        decode(message, format, args.data());
+        decode = nullptr;
+    }
+
+    /// Appends the message text (formatting deferred arguments if needed).
+    void AppendMessage(std::string& out) const {
+        if (decode)
+            decode(out, format, args.data());
+        else
+            out += message;
+
+        for (const LogField& field : fields) {
+            out += ' ';
+            out += field.key;
+            out += '=';
+            switch (field.type) {
+                case LogField::Type::Int:    std::format_to(std::back_inserter(out), "{}", field.i); break;
+                case LogField::Type::UInt:   std::format_to(std::back_inserter(out), "{}", field.u); break;
+                case LogField::Type::Double: std::format_to(std::back_inserter(out), "{}", field.d); break;
+                case LogField::Type::Bool:   out += field.b ? "true" : "false"; break;
+                case LogField::Type::String: out += field.text; break;
+            }
+        }
+    }
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Online rotation and retention settings for Logger's log file.
+ *
+ * The active file is closed and a new one opened when it grows past
+ * @ref maxFileBytes or has been open for @ref maxFileAge. Closed files are
+ * gzip-compressed and pruned by a background archiver thread.
+ * A zero value disables the corresponding limit.
+ */
+struct LogRotationConfig {
+    /// Rotate when the active file reaches this size.
+    uint64_t maxFileBytes = 32ull * 1024 * 1024;
+
+    /// Rotate when the active file has been open this long.
+    std::chrono::minutes maxFileAge{24 * 60};
+
+    /// Compress rotated files to .txt.gz.
+    bool compress = true;
+
+    /// zlib effort passed to the compressor (1 = fastest, 9 = smallest).
+    int compressionLevel = 6;
+
+    /// Delete the oldest rotated files while all of them together exceed this.
+    uint64_t maxTotalBytes = 512ull * 1024 * 1024;
+
+    /// Delete rotated files older than this.
+    std::chrono::hours maxAge{24 * 14};
+};
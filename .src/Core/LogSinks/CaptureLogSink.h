@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "LogSinkBase.h"
+
+/**
+ * @brief Records every message it receives, for checks in test and debug code.
+ *
+ * @code
+ * auto capture = std::make_shared<CaptureLogSink>();
+ * logger.AddSink(capture);
+ * ...
+ * logger.Flush();
+ * bool ok = capture->Contains(LogLevel::Error, "Missing model");
+ * @endcode
+ */
+class CaptureLogSink : public LogSinkBase {
+public:
+    struct Entry {
+        LogLevel level;
+        LogCategory category;
+        std::string message;
+    };
+
+    explicit CaptureLogSink(LogLevel level = LogLevel::Trace)
+        : LogSinkBase("capture", level) {}
+
+    void Write(const LogRecord& record) override {
+        Entry entry{record.level, record.category, {}};
+        record.AppendMessage(entry.message);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.push_back(std::move(entry));
+    }
+
+    /** @brief Moves out everything captured so far. */
+    std::vector<Entry> Take() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<Entry> out;
+        out.swap(m_entries);
+        return out;
+    }
+
+    bool Contains(LogLevel level, std::string_view text) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return std::any_of(m_entries.begin(), m_entries.end(), [&](const Entry& e) {
+            return e.level == level && e.message.find(text) != std::string::npos;
+        });
+    }
+
+    size_t Count(LogLevel level) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return static_cast<size_t>(std::count_if(m_entries.begin(), m_entries.end(),
+            [&](const Entry& e) { return e.level == level; }));
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<Entry> m_entries;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <iostream>
+
+#include "LogSinkBase.h"
+#include "DebugColors.h"
+
+/** @brief Coloured output to std::cout. */
+class ConsoleLogSink : public LogSinkBase {
+public:
+    explicit ConsoleLogSink(LogLevel level = LogLevel::Trace)
+        : LogSinkBase("console", level) {}
+
+    void Write(const LogRecord& record) override {
+        m_buffer += LevelColor(record.level);
+        m_buffer += FormatLine(record);
+        m_buffer += DebugColors::Reset;
+        m_buffer += '\n';
+    }
+
+    void Flush() override { std::cout.flush(); }
+
+    static const char* LevelColor(LogLevel level) {
+        switch (level) {
+            case LogLevel::Trace:    return DebugColors::White;     // white
+            case LogLevel::Debug:    return DebugColors::Cyan;      // cyan
+            case LogLevel::Info:     return DebugColors::Green;     // green
+            case LogLevel::Warning:  return DebugColors::Yellow;    // yellow
+            case LogLevel::Error:    return DebugColors::Red;       // red
+            case LogLevel::Critical: return DebugColors::BrightRed; // bright red
+            default:                 return DebugColors::White;
+        }
+    }
+
+protected:
+    void WriteBuffer(std::string_view data) override {
+        std::cout.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+
+#include "LogSinkBase.h"
+#include "MappedLogRing.h"
+
+/**
+ * @brief Mirrors records into a memory-mapped MappedLogRing.
+ *
+ * Records go into the mapping as they are written, not per batch: the kernel
+ * keeps them even if the process dies before the next Commit().
+ */
+class CrashRingLogSink : public LogSinkBase {
+public:
+    explicit CrashRingLogSink(LogLevel level = LogLevel::Trace)
+        : LogSinkBase("crash_ring", level) {}
+
+    bool Open(const std::string& filePath, size_t capacity) {
+        if (!m_ring.Open(filePath, capacity))
+            return false;
+
+        std::string marker = "--- session started ";
+        TimestampService::AppendDateTime(marker, TimestampService::Now());
+        marker += " ---";
+        m_ring.Append(LogLevel::Info, marker);
+        return true;
+    }
+
+    void Write(const LogRecord& record) override {
+        m_ring.Append(record.level, FormatLine(record));
+    }
+
+private:
+    MappedLogRing m_ring;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "LogSinkBase.h"
+#include "LogRotationConfig.h"
+
+class LogArchiver;
+
+/**
+ * @brief Plain-text log files named log_<timestamp>.txt in a folder, with
+ *        optional size/time rotation (see LogRotationConfig).
+ */
+class FileLogSink : public LogSinkBase {
+public:
+    explicit FileLogSink(LogLevel level = LogLevel::Trace);
+    ~FileLogSink() override;
+
+    /** @brief Opens a new log file in @p folderPath. */
+    bool Open(const std::string& folderPath);
+
+    bool IsOpen() const { return m_file.is_open(); }
+    const std::string& GetPath() const { return m_filePath; }
+
+    /**
+     * @brief Enables rotation. Closed files are compressed and pruned by a
+     *        background LogArchiver, which also picks up uncompressed logs
+     *        left by earlier runs.
+     */
+    void EnableRotation(const LogRotationConfig& config);
+
+    /** @brief Takes the archiver out; the caller destroys it (joins) outside any lock. */
+    std::unique_ptr<LogArchiver> DetachArchiver();
+
+    void Flush() override;
+
+protected:
+    void WriteBuffer(std::string_view data) override;
+
+private:
+    void OpenLogFile();
+    void RotateIfNeeded();
+
+    std::string m_logFolder;
+    std::string m_filePath;
+    std::ofstream m_file;
+
+    LogRotationConfig m_rotation;
+    uint64_t m_fileBytes = 0;
+    std::string m_fileStamp;
+    int m_fileSequence = 0;
+    std::chrono::steady_clock::time_point m_fileOpened;
+    std::unique_ptr<LogArchiver> m_archiver;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <string_view>
+
+#include "ILogSink.h"
+#include "TextLogFormatter.h"
+
+/**
+ * @brief Common part of the built-in sinks: name, level and a reusable
+ *        output buffer filled by the formatter.
+ *
+ * Derived sinks implement WriteBuffer() to hand a committed batch to their
+ * device, or override Write() when they need each record on its own.
+ */
+class LogSinkBase : public ILogSink {
+public:
+    explicit LogSinkBase(std::string name,
+                         LogLevel level = LogLevel::Trace,
+                         LogFormatter formatter = &TextLogFormatter::Append)
+        : m_name(std::move(name)), m_level(level), m_formatter(formatter) {}
+
+    std::string_view GetName() const override { return m_name; }
+
+    LogLevel GetLevel() const override { return m_level.load(std::memory_order_relaxed); }
+    void SetLevel(LogLevel level) override { m_level.store(level, std::memory_order_relaxed); }
+
+    void SetFormatter(LogFormatter formatter) override { m_formatter = formatter; }
+
+    void Write(const LogRecord& record) override { m_formatter(m_buffer, record); }
+
+    void Commit() override {
+        if (m_buffer.empty())
+            return;
+        WriteBuffer(m_buffer);
+        m_buffer.clear();
+    }
+
+    void Flush() override {}
+
+protected:
+    virtual void WriteBuffer(std::string_view data) { (void)data; }
+
+    /// Formats @p record into a scratch string without the trailing newline.
+    std::string_view FormatLine(const LogRecord& record) {
+        m_line.clear();
+        m_formatter(m_line, record);
+        if (!m_line.empty() && m_line.back() == '\n')
+            m_line.pop_back();
+        return m_line;
+    }
+
+    std::string m_name;
+    std::atomic<LogLevel> m_level;
+    LogFormatter m_formatter;
+    std::string m_buffer;
+    std::string m_line;
+};
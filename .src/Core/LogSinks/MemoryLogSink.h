@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "LogSinkBase.h"
+
+/**
+ * @brief Keeps the last @c capacity formatted lines in a lock-free ring, e.g.
+ *        for an in-game console or for asserting on log output in tests.
+ *
+ * Every slot is guarded by a sequence number (a seqlock): the writer marks
+ * the slot odd, stores the line and publishes the even value. Readers copy a
+ * slot and keep it only if the sequence did not move meanwhile, so
+ * Snapshot() never blocks the logger and a render thread never waits for it.
+ * Slot contents are relaxed atomics, so a torn read is detected, not racy.
+ *
+ * Write() relies on the logger calling sinks under its lock (one writer).
+ * Lines longer than @c LINE_CAPACITY are truncated on a UTF-8 boundary.
+ */
+class MemoryLogSink : public LogSinkBase {
+public:
+    static constexpr size_t LINE_CAPACITY = 248;
+
+    struct Line {
+        uint64_t sequence; ///< Monotonic number of the line, for incremental reads.
+        LogLevel level;
+        LogCategory category;
+        std::string text;
+    };
+
+    explicit MemoryLogSink(size_t capacity = 512, LogLevel level = LogLevel::Info)
+        : LogSinkBase("memory", level),
+          m_mask(RoundUpPow2(capacity) - 1),
+          m_slots(std::make_unique<Slot[]>(m_mask + 1)) {}
+
+    void Write(const LogRecord& record) override {
+        const std::string_view line = FormatLine(record);
+        const uint64_t index = m_head.load(std::memory_order_relaxed);
+        Slot& slot = m_slots[index & m_mask];
+
+        slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::array<uint64_t, WORDS> words{};
+        size_t length = std::min(line.size(), LINE_CAPACITY);
+        while (length < line.size() && length > 0 && (line[length] & 0xC0) == 0x80)
+            --length;
+        std::memcpy(words.data(), line.data(), length);
+        for (size_t i = 0; i < (length + 7) / 8; ++i)
+            slot.words[i].store(words[i], std::memory_order_relaxed);
+        slot.meta.store(PackMeta(record.level, record.category, length), std::memory_order_relaxed);
+
+        slot.sequence.store(index * 2 + 2, std::memory_order_release);
+        m_head.store(index + 1, std::memory_order_release);
+    }
+
+    /** @brief Copies the retained lines, oldest first. Safe from any thread. */
+    std::vector<Line> Snapshot() const {
+        uint64_t cursor = 0;
+        return SnapshotSince(cursor);
+    }
+
+    /**
+     * @brief Copies lines newer than @p cursor and advances it.
+     *
+     * A console polls with the same cursor every frame and only receives new
+     * lines. Lines overwritten before they were read are skipped.
+     */
+    std::vector<Line> SnapshotSince(uint64_t& cursor) const {
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+        const uint64_t capacity = m_mask + 1;
+        uint64_t first = std::max({cursor, m_clearedTo.load(std::memory_order_relaxed),
+                                   head > capacity ? head - capacity : 0});
+
+        std::vector<Line> out;
+        out.reserve(static_cast<size_t>(head - std::min(first, head)));
+
+        for (uint64_t index = first; index < head; ++index) {
+            Line line;
+            if (ReadSlot(index, line))
+                out.push_back(std::move(line));
+        }
+        cursor = std::max(cursor, head);
+        return out;
+    }
+
+    /** @brief Number of lines written since construction. */
+    uint64_t GetWrittenCount() const noexcept { return m_head.load(std::memory_order_relaxed); }
+
+    /** @brief Hides everything written so far from later snapshots. */
+    void Clear() { m_clearedTo.store(m_head.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+
+    /** @brief Checks whether a retained line of @p level contains @p text. */
+    bool Contains(LogLevel level, std::string_view text) const {
+        const auto lines = Snapshot();
+        return std::any_of(lines.begin(), lines.end(), [&](const Line& l) {
+            return l.level == level && l.text.find(text) != std::string::npos;
+        });
+    }
+
+    /** @brief Counts retained lines at or above @p level. */
+    size_t CountAtLeast(LogLevel level) const {
+        const auto lines = Snapshot();
+        return static_cast<size_t>(std::count_if(lines.begin(), lines.end(),
+            [&](const Line& l) { return l.level >= level; }));
+    }
+
+private:
+    static constexpr size_t WORDS = (LINE_CAPACITY + 7) / 8;
+
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> meta{0};
+        std::array<std::atomic<uint64_t>, WORDS> words{};
+    };
+
+    static uint64_t PackMeta(LogLevel level, LogCategory category, size_t length) {
+        return static_cast<uint64_t>(level) |
+               (static_cast<uint64_t>(category) << 8) |
+               (static_cast<uint64_t>(length) << 16);
+    }
+
+    bool ReadSlot(uint64_t index, Line& line) const {
+        const Slot& slot = m_slots[index & m_mask];
+        const uint64_t expected = index * 2 + 2;
+
+        if (slot.sequence.load(std::memory_order_acquire) != expected)
+            return false; // already overwritten
+
+        const uint64_t meta = slot.meta.load(std::memory_order_relaxed);
+        const size_t length = std::min(static_cast<size_t>(meta >> 16), LINE_CAPACITY);
+
+        std::array<uint64_t, WORDS> words;
+        for (size_t i = 0; i < (length + 7) / 8; ++i)
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != expected)
+            return false;
+
+        line.sequence = index;
+        line.level = static_cast<LogLevel>(meta & 0xFF);
+        line.category = static_cast<LogCategory>((meta >> 8) & 0xFF);
+        line.text.assign(reinterpret_cast<const char*>(words.data()), length);
+        return true;
+    }
+
+    static size_t RoundUpPow2(size_t v) {
+        size_t p = 2;
+        while (p < v)
+            p <<= 1;
+        return p;
+    }
+
+    const size_t m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+    std::atomic<uint64_t> m_head{0};
+    std::atomic<uint64_t> m_clearedTo{0};
+};
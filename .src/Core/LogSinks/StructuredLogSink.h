@@ -0,0 +1,35 @@
+#pragma once
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "LogSinkBase.h"
+#include "JsonLogFormatter.h"
+
+/** @brief One JSON object per line (see JsonLogFormatter) appended to a single file. */
+class StructuredLogSink : public LogSinkBase {
+public:
+    explicit StructuredLogSink(const std::string& filePath, LogLevel level = LogLevel::Trace)
+        : LogSinkBase("structured", level, &JsonLogFormatter::Append) {
+        m_file.open(filePath, std::ios::app | std::ios::binary);
+        if (!m_file)
+            std::cerr << "[Logger] Failed to open structured log file: " << filePath << std::endl;
+    }
+
+    bool IsOpen() const { return m_file.is_open(); }
+
+    void Flush() override {
+        if (m_file.is_open())
+            m_file.flush();
+    }
+
+protected:
+    void WriteBuffer(std::string_view data) override {
+        if (m_file.is_open())
+            m_file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+private:
+    std::ofstream m_file;
+};
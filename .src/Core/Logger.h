@@ -1,14 +1,29 @@
 #pragma once
 
 #include "ILogger.h"
+#include "LogRecord.h"
+#include "AsyncLogConfig.h"
+#include "LogRotationConfig.h"
+#include "MpscRingBuffer.h"
+#include "MappedLogRing.h"
+#include "ILogSink.h"
 
 #include <fstream>
 #include <iostream>
 #include <mutex>
 #include <chrono>
 #include <iomanip>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <memory>
+#include <array>
+#include <vector>
 
-class Logger : public ILogger {
+class ConsoleLogSink;
+class FileLogSink;
+
+class Logger final : public ILogger {
 public:
     static Logger& Instance() {
         static Logger instance;
@@ -27,27 +42,136 @@ public:
     void Error(std::string_view message) override { Log(LogLevel::Error, message); }
     void Critical(std::string_view message) override { Log(LogLevel::Critical, message); }
 
-    void SetLogLevel(LogLevel level) override { m_logLevel = level; }
+    void SetLogLevel(LogLevel level) override;
     LogLevel GetLogLevel() const override { return m_logLevel; }
 
-    void SetOutput(LogOutput output) override { m_output = output; }
+    void SetCategoryLevel(LogCategory category, LogLevel level) override;
+    void ResetCategoryLevel(LogCategory category) override;
+
+    LogLevel GetCategoryLevel(LogCategory category) const override {
+        return m_categoryLevels[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+    }
+
+    /** @brief One relaxed load; used by the LOG_* macros before any argument is evaluated. */
+    bool ShouldLog(LogCategory category, LogLevel level) const override {
+        return level >= m_categoryLevels[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+    }
+
+    void SetOutput(LogOutput output) override;
     LogOutput GetOutput() const override { return m_output; }
 
     void SetLogFile(const std::string& folderPath) override;
     void CleanupOldLogs(const std::string& folderPath, size_t maxLogs = 10) override;
-    const std::string& GetLogFile() const override { return m_filePath; }
+    std::string GetLogFile() const override;
+
+    void Flush() override;
+    void Submit(LogRecord&& record) override;
+
+    /**
+     * @brief Switches to asynchronous logging.
+     *
+     * Log() then only pushes a record into a lock-free queue; a backend thread
+     * formats and writes records in batches according to @p config.
+     * Calling it again while async restarts the backend with the new config.
+     */
+    void EnableAsync(const AsyncLogConfig& config = {});
+
+    /** @brief Drains the queue, stops the backend thread and returns to synchronous logging. */
+    void DisableAsync();
+
+    bool IsAsync() const { return m_async.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Adds an output. Records below the sink's own level are never
+     *        formatted for it. A sink with the same name is replaced.
+     *
+     * The built-in "console" and "file" sinks are managed through SetOutput()
+     * and SetLogFile(); their levels can still be changed via FindSink().
+     */
+    void AddSink(std::shared_ptr<ILogSink> sink);
+    void RemoveSink(std::string_view name);
+    std::shared_ptr<ILogSink> FindSink(std::string_view name);
+
+    /**
+     * @brief Enables size/time based rotation of the log file.
+     *
+     * Requires SetLogFile() first. The check runs where the file is written:
+     * on the backend thread in async mode. Closed files are compressed and
+     * pruned by a background LogArchiver, which also picks up uncompressed
+     * logs left by earlier runs.
+     */
+    void EnableRotation(const LogRotationConfig& config = {});
+
+    /** @brief Stops rotating; waits for the archiver to finish queued work. */
+    void DisableRotation();
+
+    /**
+     * @brief Adds a StructuredLogSink ("structured"): one JSON object per line
+     *        in @p filePath, see JsonLogFormatter for the layout.
+     */
+    void SetStructuredLogFile(const std::string& filePath);
+    void DisableStructuredLog();
+
+    /**
+     * @brief Adds a CrashRingLogSink ("crash_ring") that mirrors every record
+     *        into a memory-mapped ring file.
+     *
+     * The last @p capacity bytes of log survive a crash or a kill without any
+     * flushing (see MappedLogRing); read them with the LogRingReader tool.
+     * In async mode records still queued at the moment of a crash are lost,
+     * everything the backend already handled is kept.
+     */
+    bool EnableCrashRing(const std::string& filePath, size_t capacity = MappedLogRing::DEFAULT_CAPACITY);
+    void DisableCrashRing();
+
+    /** @brief Number of records lost to the overflow policy since startup. */
+    uint64_t GetDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
 
 private:
     Logger(LogLevel level = LogLevel::Info, LogOutput output = LogOutput::Console);
     ~Logger() override;
 
-    std::mutex m_mutex;
+    mutable std::mutex m_mutex; // output lock: guards the sinks and everything they write to
     LogLevel m_logLevel;
     LogOutput m_output;
-    std::string m_filePath;
-    std::ofstream m_file;
 
-    std::string GetTimeStamp() const;
-    std::string LevelToString(LogLevel level) const;
-    const char* LevelColor(LogLevel level) const;
+    // --- Sinks (guarded by m_mutex) ---
+    std::shared_ptr<ConsoleLogSink> m_consoleSink;
+    std::shared_ptr<FileLogSink> m_fileSink;
+    std::vector<std::shared_ptr<ILogSink>> m_extraSinks;
+    std::vector<ILogSink*> m_activeSinks; // console/file per m_output, then extras
+
+    // --- Category filters ---
+    std::array<std::atomic<LogLevel>, LOG_CATEGORY_COUNT> m_categoryLevels;
+    std::array<bool, LOG_CATEGORY_COUNT> m_categoryOverridden{}; // guarded by m_levelMutex
+    std::mutex m_levelMutex;
+
+    // --- Async backend ---
+    AsyncLogConfig m_asyncConfig; // changed only while m_async is false and m_producers is 0
+    std::unique_ptr<MpscRingBuffer<LogRecord>> m_queue;
+    std::atomic<bool> m_async{false};
+    std::atomic<bool> m_backendStop{false};
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<uint64_t> m_enqueued{0};
+    std::atomic<uint64_t> m_written{0};
+    std::atomic<uint64_t> m_flushed{0};
+    std::atomic<uint32_t> m_producers{0}; // callers inside the async branch of Submit()
+    bool m_flushRequested = false; // guarded by m_backendMutex
+    std::thread m_backend;
+    std::mutex m_backendMutex;
+    std::condition_variable m_backendCv;
+    std::condition_variable m_spaceCv;
+    std::condition_variable m_drainedCv;
+    std::mutex m_asyncControlMutex;
+
+    void RebuildActiveSinks();
+    size_t Dispatch(LogRecord& record);
+    void CommitSinks();
+    void FlushSinks();
+
+    bool Enqueue(LogRecord& record);
+    void BackendLoop();
+    size_t WriteBatch(bool& urgent);
+    size_t WriteDedupRepeats();
+    void WriteStragglers();
 };
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+/**
+ * @brief A file mapped into memory (Windows file mapping / POSIX mmap).
+ *
+ * Writes to a read-write mapping land in the OS page cache and reach the
+ * file even if the process is killed right after; Flush() is only needed
+ * to survive a power loss.
+ */
+class MappedFile {
+public:
+    enum class Access {
+        ReadOnly,  ///< Map an existing file as it is.
+        ReadWrite  ///< Create the file if needed; resize it when a size is given.
+    };
+
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Maps @p path, closing any previous mapping.
+     * @param size For ReadWrite: new file size in bytes (0 keeps the current size).
+     * @return false if the file could not be opened, resized or mapped.
+     */
+    bool Open(const std::filesystem::path& path, Access access, size_t size = 0);
+
+    void Close() noexcept;
+
+    /** @brief Writes dirty pages back to disk; @p wait blocks until they are written. */
+    void Flush(bool wait = false) noexcept;
+
+    bool IsOpen() const noexcept { return m_data != nullptr; }
+    std::byte* Data() noexcept { return static_cast<std::byte*>(m_data); }
+    const std::byte* Data() const noexcept { return static_cast<const std::byte*>(m_data); }
+    size_t Size() const noexcept { return m_size; }
+
+private:
+    void* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    void* m_file = nullptr;    // HANDLE
+    void* m_mapping = nullptr; // HANDLE
+#else
+    int m_fd = -1;
+#endif
+};
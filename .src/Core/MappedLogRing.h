@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "LogLevel.h"
+#include "MappedFile.h"
+
+/**
+ * @brief Crash-safe log tail: a fixed-size ring of records in a memory-mapped file.
+ *
+ * Every record is copied into the mapping as a small checksummed frame, so
+ * the last @c capacity bytes of log survive a crash or kill without any
+ * fsync. An existing ring with the same capacity is continued, so the tail
+ * of a crashed session is still there after a restart (until overwritten).
+ * Read it back with ReadFile() or the LogRingReader tool.
+ *
+ * File layout: a 64-byte Header, then @c capacity bytes of frames written
+ * as one circular byte stream. Header::writePos counts all bytes ever
+ * written and is published only after a frame is complete.
+ */
+class MappedLogRing {
+public:
+    struct Entry {
+        LogLevel level;
+        std::string text;
+    };
+
+    static constexpr size_t DEFAULT_CAPACITY = 8 * 1024 * 1024;
+
+    MappedLogRing() = default;
+
+    /** @brief Maps (or creates) the ring file with @p capacity bytes of record space. */
+    bool Open(const std::filesystem::path& path, size_t capacity = DEFAULT_CAPACITY);
+    void Close();
+    bool IsOpen() const { return m_map.IsOpen(); }
+
+    /** @brief Appends one record. Thread-safe; text longer than the ring is cut. */
+    void Append(LogLevel level, std::string_view text);
+
+    /** @brief Decodes the records still present in a mapped ring image, oldest first. */
+    static std::vector<Entry> Read(const std::byte* data, size_t size);
+
+    /** @brief Maps @p path read-only and decodes it. Empty if it is not a ring file. */
+    static std::vector<Entry> ReadFile(const std::filesystem::path& path);
+
+private:
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t headerSize;
+        uint64_t capacity;
+        uint64_t writePos;   // total bytes written, published with release order
+        uint8_t reserved[32];
+    };
+    static_assert(sizeof(Header) == 64);
+
+    struct Frame {
+        uint32_t marker;
+        uint32_t size;       // payload bytes
+        uint32_t crc;        // CRC-32 of the payload
+        uint8_t level;
+        uint8_t reserved[3];
+    };
+    static_assert(sizeof(Frame) == 16);
+
+    static constexpr char MAGIC[8] = {'M', 'X', 'L', 'O', 'G', 'R', 'N', 'G'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t FRAME_MARKER = 0x3152474C; // "LGR1"
+
+    void Write(uint64_t pos, const void* src, size_t size);
+    static void ReadAt(const std::byte* ring, uint64_t capacity, uint64_t pos, void* dst, size_t size);
+
+    Header* HeaderPtr() { return reinterpret_cast<Header*>(m_map.Data()); }
+    std::byte* Ring() { return m_map.Data() + sizeof(Header); }
+
+    std::mutex m_mutex;
+    MappedFile m_map;
+    uint64_t m_capacity = 0;
+};
@@ -2,9 +2,11 @@
 
 #include <fstream>
 #include <stdexcept>
+#include <string>
 #include <nlohmann/json.hpp>
 
 #include "IOptions.h"
+#include "JsonParseMode.h"
 #include "Logger.h"
 
 using nlohmann::json;
@@ -19,6 +21,7 @@ using nlohmann::json;
  * @tparam T Configuration structure type that:
  *  - supports deserialization via `from_json(const json&, T&)`
  *  - may optionally define a global `Validate(const T&)` function
+ *  - may opt into streaming parsing via @ref JsonParseTraits
  *
  */
 template <typename T>
@@ -36,14 +39,26 @@ private:
      * @throws std::invalid_argument If validation fails (when Validate() exists).
      */
     static T LoadFromJson(const std::string& filename) {
-        std::ifstream file(filename);
+        std::ifstream file(filename, std::ios::binary);
         if (!file.is_open()) {
             Logger::Instance().Critical("Cannot open config file: " + filename);
         }
 
-        json j;
-        file >> j;
-        T config = j.get<T>();
+        T config;
+        if constexpr (JsonParseTraits<T>::mode == JsonParseMode::Sax) {
+            // One read into a per-thread buffer, then no per-value allocations.
+            thread_local std::string text;
+            file.seekg(0, std::ios::end);
+            const std::streamoff size = file.tellg();
+            text.resize(size > 0 ? static_cast<size_t>(size) : 0);
+            file.seekg(0, std::ios::beg);
+            file.read(text.data(), static_cast<std::streamsize>(text.size()));
+            config = JsonSaxReader<T>::Parse(text);
+        } else {
+            json j;
+            file >> j;
+            config = j.get<T>();
+        }
 
         // If a global Validate() function exists for type T — call it
         if constexpr (requires(const T& c) { Validate(c); }) {
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief An interned string: a 32-bit id into the process-wide symbol table.
+ *
+ * Equal texts always intern to the same id, so comparing and hashing
+ * symbols is an integer operation and every distinct name is stored once.
+ * Interning is thread-safe; reading the text back is lock-free.
+ *
+ * Interned text lives until the process exits. That suits names read from
+ * resource files (blocks, models, textures, variant keys), not unbounded
+ * input.
+ *
+ * The default symbol is the empty string (id 0).
+ *
+ * @code
+ * const Symbol texture("block/dirt");
+ * if (texture == Symbol("block/dirt"))     // one integer compare
+ *     atlas.Find(texture.View());
+ * std::unordered_map<Symbol, uint32_t> index; // hashes the id
+ * @endcode
+ */
+class Symbol {
+public:
+    constexpr Symbol() noexcept = default;
+
+    /** @brief Interns @p text. */
+    explicit Symbol(std::string_view text);
+    explicit Symbol(const std::string& text) : Symbol(std::string_view(text)) {}
+    explicit Symbol(const char* text) : Symbol(std::string_view(text)) {}
+
+    /**
+     * @brief Looks up @p text without interning it.
+     *
+     * Use it for lookups with names from outside the resource files: a
+     * text that was never interned cannot be a key in any symbol map.
+     */
+    static std::optional<Symbol> Find(std::string_view text);
+
+    /** @brief Number of distinct texts interned so far, including the empty one. */
+    static size_t Count() noexcept;
+
+    uint32_t Id() const noexcept { return m_id; }
+    bool Empty() const noexcept { return m_id == 0; }
+
+    /** @brief The interned text; valid for the lifetime of the process. */
+    std::string_view View() const noexcept;
+
+    std::string Str() const { return std::string(View()); }
+
+    /** @brief Symbols read as text wherever a view is expected (log arguments, lookups). */
+    operator std::string_view() const noexcept { return View(); }
+
+    friend bool operator==(Symbol, Symbol) noexcept = default;
+
+private:
+    uint32_t m_id = 0;
+};
+
+template <>
+struct std::hash<Symbol> {
+    size_t operator()(Symbol symbol) const noexcept { return symbol.Id(); }
+};
+
+template <>
+struct std::formatter<Symbol> : std::formatter<std::string_view> {
+    auto format(Symbol symbol, std::format_context& ctx) const {
+        return std::formatter<std::string_view>::format(symbol.View(), ctx);
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& os, Symbol symbol) {
+    return os << symbol.View();
+}
+
+/**
+ * @brief nlohmann::json support: a symbol is read from a JSON string.
+ *
+ * A template, so this header does not need the json headers.
+ *
+ * @throws nlohmann::json::type_error If @p j is not a string.
+ */
+template <typename BasicJsonType>
+void from_json(const BasicJsonType& j, Symbol& symbol) {
+    symbol = Symbol(j.template get_ref<const typename BasicJsonType::string_t&>());
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+
+#include "LogRecord.h"
+#include "TimestampService.h"
+
+/**
+ * @brief The human-readable line layout: "[HH:MM:SS.uuuuuu] [LEVEL] message".
+ */
+class TextLogFormatter {
+public:
+    static void Append(std::string& out, const LogRecord& record) {
+        out += '[';
+        TimestampService::AppendTime(out, record.time);
+        out += "] [";
+        out += ToString(record.level);
+        out += "] ";
+        record.AppendMessage(out);
+        out += '\n';
+    }
+};
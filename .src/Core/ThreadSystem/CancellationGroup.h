@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include "CancellationToken.h"
+
+// Packs chunk coordinates into a group tag.
+inline constexpr uint64_t ChunkTag(int32_t x, int32_t z) noexcept
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+}
+
+// Cancels whole groups of tasks by tag, e.g. everything queued for chunk (x,z).
+//
+// All tasks of a tag share one CancellationSource, so Cancel(tag) flips a
+// single flag and every task sees it in O(1) when it is dequeued.
+// After Cancel() the tag starts over: the next GetToken() returns a fresh,
+// uncancelled token (the chunk came back into view).
+class CancellationGroup
+{
+public:
+    CancellationToken GetToken(uint64_t tag)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sources_[tag].GetToken();
+    }
+
+    // Cancels every task tagged with `tag`. Returns false if the tag was unknown.
+    bool Cancel(uint64_t tag)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = sources_.find(tag);
+        if (it == sources_.end())
+            return false;
+
+        it->second.Cancel();
+        sources_.erase(it);
+        return true;
+    }
+
+    void CancelAll()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [_, source] : sources_)
+            source.Cancel();
+        sources_.clear();
+    }
+
+    size_t GetActiveGroups() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sources_.size();
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, CancellationSource> sources_;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+// Shared flag behind a CancellationSource and all of its tokens.
+struct CancellationState
+{
+    std::atomic<bool> cancelled{false};
+};
+
+// Read-only view of a cancellation flag.
+// Cheap to copy (one shared_ptr). A default-constructed token is never cancelled.
+// Long-running tasks should poll IsCancellationRequested() between steps.
+class CancellationToken
+{
+public:
+    CancellationToken() noexcept = default;
+
+    // True once the owning source has been cancelled.
+    inline bool IsCancellationRequested() const noexcept
+    {
+        return state_ && state_->cancelled.load(std::memory_order_acquire);
+    }
+
+    // False for default tokens that can never be cancelled.
+    inline bool CanBeCancelled() const noexcept
+    {
+        return static_cast<bool>(state_);
+    }
+
+private:
+    friend class CancellationSource;
+
+    explicit CancellationToken(std::shared_ptr<const CancellationState> state) noexcept
+        : state_(std::move(state))
+    {
+    }
+
+    std::shared_ptr<const CancellationState> state_;
+};
+
+// Owns a cancellation flag and hands out tokens for it.
+// Cancel() is O(1) no matter how many tasks hold a token.
+class CancellationSource
+{
+public:
+    CancellationSource()
+        : state_(std::make_shared<CancellationState>())
+    {
+    }
+
+    CancellationToken GetToken() const noexcept
+    {
+        return CancellationToken(state_);
+    }
+
+    inline void Cancel() noexcept
+    {
+        state_->cancelled.store(true, std::memory_order_release);
+    }
+
+    inline bool IsCancellationRequested() const noexcept
+    {
+        return state_->cancelled.load(std::memory_order_acquire);
+    }
+
+private:
+    std::shared_ptr<CancellationState> state_;
+};
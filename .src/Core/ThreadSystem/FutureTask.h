@@ -1,13 +1,14 @@
 #pragma once
 
 #include "ITask.h"
+#include "TaskErrorChannel.h"
 
-#include <iostream>
 #include <exception>
 
 struct TaskResult
 {
     bool success;
+    bool cancelled = false;
 };
 
 struct FutureTask : ITask
@@ -15,12 +16,36 @@ struct FutureTask : ITask
     std::function<void()> func;
     std::function<void(const std::exception &)> errorCallback;
     std::function<void(TaskResult)> futureResultCallback;
+    CancellationToken cancellation;
+    TaskType type = TaskType::Light;
 
     void SetErrorCallback(const std::function<void(const std::exception &)> &callback) override
     {
         errorCallback = callback;
     }
 
+    void SetCancellationToken(CancellationToken token) override
+    {
+        cancellation = std::move(token);
+    }
+
+    bool IsCancelled() const noexcept override
+    {
+        return cancellation.IsCancellationRequested();
+    }
+
+    void SetTaskType(TaskType t) override
+    {
+        type = t;
+    }
+
+    // The waiter still gets a result, so it never hangs on a revoked task.
+    void OnCancelled() override
+    {
+        if (futureResultCallback)
+            futureResultCallback(TaskResult{false, true});
+    }
+
     void operator()() override
     {
         TaskResult result;
@@ -33,9 +58,14 @@ struct FutureTask : ITask
         {
             result.success = false;
             if (errorCallback)
+            {
+                TaskErrorChannel::Instance().Count(type);
                 errorCallback(ex);
+            }
             else
-                std::cerr << "[Task exception] " << ex.what() << "\n";
+            {
+                TaskErrorChannel::Instance().Report(std::current_exception(), type, "FutureTask");
+            }
         }
         catch (...)
         {
@@ -43,16 +73,15 @@ struct FutureTask : ITask
             if (errorCallback)
             {
                 std::runtime_error unknown("Unknown exception");
+                TaskErrorChannel::Instance().Count(type);
                 errorCallback(unknown);
             }
             else
             {
-                std::cerr << "[Task exception] unknown\n";
+                TaskErrorChannel::Instance().Report(std::current_exception(), type, "FutureTask");
             }
         }
         if (futureResultCallback)
             futureResultCallback(result);
-        else
-            std::cerr << "[Task exception] unknown\n";
     }
 };
\ No newline at end of file
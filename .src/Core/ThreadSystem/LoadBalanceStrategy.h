@@ -10,7 +10,7 @@ struct LoadBalanceStrategy : IDispatchStrategy
 {
     IWorker& SelectWorker(
         const std::vector<std::unique_ptr<IWorker>>& workers,
-        TaskType type
+        TaskType /*type*/
     ) override
     {
         size_t bestIndex = 0;
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#include "WorkerConfig.h"
+
+// Bounded lock-free ring buffer (Vyukov's sequence-per-cell queue).
+//
+// Built for many producers and one consumer, but pops are also safe from
+// several threads, which lets a producer evict the oldest element on overflow.
+// Neither side ever blocks: TryPush fails when full, TryPop when empty.
+//
+// T must be default-constructible and move-assignable.
+template <typename T>
+class MpscRingBuffer
+{
+public:
+    explicit MpscRingBuffer(size_t capacity)
+        : mask_(RoundUpPow2(capacity) - 1),
+          cells_(std::make_unique<Cell[]>(mask_ + 1))
+    {
+        for (size_t i = 0; i <= mask_; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    bool TryPush(T&& value) noexcept
+    {
+        Cell* cell;
+        size_t pos = head_.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            cell = &cells_[pos & mask_];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false; // full
+            }
+            else
+            {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(T& out) noexcept
+    {
+        Cell* cell;
+        size_t pos = tail_.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            cell = &cells_[pos & mask_];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+            if (diff == 0)
+            {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false; // empty
+            }
+            else
+            {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+
+        out = std::move(cell->value);
+        cell->value = T{};
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate number of queued elements.
+    size_t SizeApprox() const noexcept
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        return head >= tail ? head - tail : 0;
+    }
+
+    bool EmptyApprox() const noexcept
+    {
+        return SizeApprox() == 0;
+    }
+
+    size_t Capacity() const noexcept
+    {
+        return mask_ + 1;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    static size_t RoundUpPow2(size_t v)
+    {
+        if (v < 2)
+            return 2;
+        size_t p = 1;
+        while (p < v)
+            p <<= 1;
+        return p;
+    }
+
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+};
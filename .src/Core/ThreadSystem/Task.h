@@ -1,8 +1,8 @@
 #pragma once
 
 #include "ITask.h"
+#include "TaskErrorChannel.h"
 
-#include <iostream>
 #include <exception>
 #include <functional>
 
@@ -17,9 +17,15 @@ struct Task : ITask
     std::function<void()> func;
 
     // Optional exception callback.
-    // If not set, fallback logging is used.
+    // If not set, the exception goes to the pool's TaskErrorChannel.
     std::function<void(const std::exception&)> errorCallback;
 
+    // Optional cancellation token. Checked by the worker before execution.
+    CancellationToken cancellation;
+
+    // Category the task was submitted to (set by ThreadPool::AddTask).
+    TaskType type = TaskType::Light;
+
 
     // Sets a custom exception handler.
     void SetErrorCallback(const std::function<void(const std::exception&)>& callback) override
@@ -27,6 +33,24 @@ struct Task : ITask
         errorCallback = callback;
     }
 
+    void SetCancellationToken(CancellationToken token) override
+    {
+        cancellation = std::move(token);
+    }
+
+    bool IsCancelled() const noexcept override
+    {
+        return cancellation.IsCancellationRequested();
+    }
+
+    void SetTaskType(TaskType t) override
+    {
+        type = t;
+    }
+
+    // Cancelled plain tasks are simply dropped.
+    void OnCancelled() override {}
+
 
     // Executes the task with fully isolated error handling.
     // Uses fast-path for the common case where no exception occurs.
@@ -41,12 +65,13 @@ struct Task : ITask
             // If a handler exists, use it.
             if (LIKELY(errorCallback))
             {
+                TaskErrorChannel::Instance().Count(type);
                 errorCallback(ex);
             }
             else
             {
-                // Fallback: minimal logging
-                std::cerr << "[Task exception] " << ex.what() << "\n";
+                // Fallback: queue for asynchronous logging, never block here
+                TaskErrorChannel::Instance().Report(std::current_exception(), type, "Task");
             }
         }
         catch (...)
@@ -55,11 +80,12 @@ struct Task : ITask
             if (LIKELY(errorCallback))
             {
                 static const std::runtime_error unknown("Unknown exception");
+                TaskErrorChannel::Instance().Count(type);
                 errorCallback(unknown);
             }
             else
             {
-                std::cerr << "[Task exception] unknown\n";
+                TaskErrorChannel::Instance().Report(std::current_exception(), type, "Task");
             }
         }
     }
@@ -39,7 +39,7 @@ struct TaskCategoryStrategy : IDispatchStrategy
         size_t lightWorkers =
             (workerCount >= 15) ? LIGHT_FOR_15 :
             (workerCount >= 8)  ? LIGHT_FOR_8 :
-            (workerCount == 4)  ? LIGHT_FOR_4 : 0;
+            LIGHT_FOR_4; // 4..7 workers: one light worker, the rest heavy
 
         size_t heavyWorkers = workerCount - ioWorkers - lightWorkers;
 
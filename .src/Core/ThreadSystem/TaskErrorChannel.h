@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <thread>
+
+#include "ILogger.h"
+#include "LogMacros.h"
+#include "MpscRingBuffer.h"
+#include "TaskType.h"
+
+// One failed task, captured on the worker without formatting anything.
+struct TaskError
+{
+    std::exception_ptr exception;
+    TaskType type = TaskType::Light;
+    const char* source = "";                 // "Task", "FutureTask", ...
+    std::chrono::system_clock::time_point time;
+    std::thread::id thread;
+};
+
+// Pool-wide sink for exceptions thrown by tasks.
+//
+// Workers push into a lock-free ring and never touch iostreams; a drainer
+// (ThreadPool's periodic error drain, see ThreadPool::SetErrorLogger)
+// formats and logs them later. On overflow new errors are dropped and
+// counted, so a burst of failures can never stall a worker.
+class TaskErrorChannel
+{
+public:
+    static constexpr size_t CAPACITY = 1024;
+    static constexpr size_t CATEGORY_COUNT = 3;
+
+    static TaskErrorChannel& Instance()
+    {
+        static TaskErrorChannel instance;
+        return instance;
+    }
+
+    TaskErrorChannel(const TaskErrorChannel&) = delete;
+    TaskErrorChannel& operator=(const TaskErrorChannel&) = delete;
+
+    // Counts a failure that was already handled by the task's error callback.
+    inline void Count(TaskType type) noexcept
+    {
+        errorCounts_[static_cast<size_t>(type)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Counts and queues an unhandled failure. Call from inside a catch block
+    // or pass std::current_exception().
+    void Report(std::exception_ptr exception, TaskType type, const char* source) noexcept
+    {
+        Count(type);
+
+        TaskError error;
+        error.exception = std::move(exception);
+        error.type = type;
+        error.source = source;
+        error.time = std::chrono::system_clock::now();
+        error.thread = std::this_thread::get_id();
+
+        if (!ring_.TryPush(std::move(error)))
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Pops at most `maxErrors` queued errors and hands them to `fn`.
+    template <typename Fn>
+    size_t Drain(Fn&& fn, size_t maxErrors = CAPACITY)
+    {
+        size_t n = 0;
+        TaskError error;
+        while (n < maxErrors && ring_.TryPop(error))
+        {
+            fn(error);
+            ++n;
+        }
+        return n;
+    }
+
+    // Logs queued errors and a summary of errors dropped since the last drain.
+    size_t DrainTo(ILogger& logger, size_t maxErrors = CAPACITY)
+    {
+        size_t n = Drain([&](const TaskError& e)
+        {
+            // A task failing in a loop repeats the same line; collapse the copies.
+            LOG_DEDUPED(logger, LogCategory::ThreadSystem, LogLevel::Error, "[Task exception] {} ({}): {}",
+                        e.source, ToString(e.type), Describe(e.exception));
+        }, maxErrors);
+
+        const uint64_t dropped = dropped_.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0)
+        {
+            LOG_WARNING(logger, LogCategory::ThreadSystem,
+                        "[Task exception] {} task errors dropped (error channel full)", dropped);
+        }
+        return n;
+    }
+
+    bool HasPending() const noexcept
+    {
+        return !ring_.EmptyApprox() || dropped_.load(std::memory_order_relaxed) > 0;
+    }
+
+    uint64_t GetErrorCount(TaskType type) const noexcept
+    {
+        return errorCounts_[static_cast<size_t>(type)].load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetDroppedCount() const noexcept
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    static std::string Describe(const std::exception_ptr& exception)
+    {
+        if (!exception)
+            return "unknown";
+        try
+        {
+            std::rethrow_exception(exception);
+        }
+        catch (const std::exception& ex)
+        {
+            return ex.what();
+        }
+        catch (...)
+        {
+            return "unknown";
+        }
+    }
+
+    static const char* ToString(TaskType type) noexcept
+    {
+        switch (type)
+        {
+            case TaskType::IO:    return "IO";
+            case TaskType::Light: return "Light";
+            case TaskType::Heavy: return "Heavy";
+            default:              return "Unknown";
+        }
+    }
+
+private:
+    TaskErrorChannel() : ring_(CAPACITY) {}
+
+    MpscRingBuffer<TaskError> ring_;
+    std::array<std::atomic<uint64_t>, CATEGORY_COUNT> errorCounts_{};
+    std::atomic<uint64_t> dropped_{0};
+};
@@ -29,4 +29,25 @@ struct TaskFactory
         task->SetErrorCallback(std::move(errorCallback));
         return task;
     }
+
+    // --- Создаёт Task, который можно отменить через token ---
+    static std::unique_ptr<ITask> MakeTask(std::function<void()> func,
+                                           CancellationToken token,
+                                           std::function<void(const std::exception&)> errorCallback = nullptr)
+    {
+        auto task = MakeTask(std::move(func), std::move(errorCallback));
+        task->SetCancellationToken(std::move(token));
+        return task;
+    }
+
+    // --- Создаёт FutureTask, который можно отменить через token ---
+    static std::unique_ptr<ITask> MakeFutureTask(std::function<void()> func,
+                                                 std::function<void(TaskResult)> futureCallback,
+                                                 CancellationToken token,
+                                                 std::function<void(const std::exception&)> errorCallback = nullptr)
+    {
+        auto task = MakeFutureTask(std::move(func), std::move(futureCallback), std::move(errorCallback));
+        task->SetCancellationToken(std::move(token));
+        return task;
+    }
 };
\ No newline at end of file
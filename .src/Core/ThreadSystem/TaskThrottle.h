@@ -0,0 +1,318 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <algorithm>
+#include <iterator>
+
+#include "ITask.h"
+#include "TaskType.h"
+
+// Budget for one task category. A zero field means "unlimited".
+struct ThrottleLimits
+{
+    // Maximum number of tasks started per second.
+    double tasksPerSecond = 0.0;
+
+    // Maximum CPU time (in ms) the category may consume per second,
+    // measured as time spent executing on a worker thread.
+    double cpuMsPerSecond = 0.0;
+
+    // How many seconds of budget may accumulate while the category is idle.
+    double burstSeconds = 1.0;
+
+    bool IsUnlimited() const noexcept
+    {
+        return tasksPerSecond <= 0.0 && cpuMsPerSecond <= 0.0;
+    }
+};
+
+// Classic token bucket. Not thread-safe on its own: guarded by TaskThrottle.
+struct TokenBucket
+{
+    double rate = 0.0;     // tokens per second, 0 = unlimited
+    double capacity = 0.0; // max tokens
+    double tokens = 0.0;   // may go negative when charged after the fact
+    std::chrono::steady_clock::time_point last = std::chrono::steady_clock::now();
+
+    void Configure(double ratePerSecond, double burstSeconds)
+    {
+        rate = ratePerSecond;
+        capacity = std::max(1.0, ratePerSecond * burstSeconds);
+        tokens = capacity;
+        last = std::chrono::steady_clock::now();
+    }
+
+    void Refill(std::chrono::steady_clock::time_point now)
+    {
+        if (rate <= 0.0)
+            return;
+        const double dt = std::chrono::duration<double>(now - last).count();
+        last = now;
+        tokens = std::min(capacity, tokens + dt * rate);
+    }
+
+    bool HasBudget() const noexcept
+    {
+        return rate <= 0.0 || tokens > 0.0;
+    }
+
+    bool HasTokens(double amount) const noexcept
+    {
+        return rate <= 0.0 || tokens >= amount;
+    }
+
+    void Charge(double amount) noexcept
+    {
+        if (rate > 0.0)
+            tokens -= amount;
+    }
+};
+
+class TaskThrottle;
+
+// Wraps a task of a CPU-limited category and charges its run time to the bucket.
+struct ThrottledTask : ITask
+{
+    std::unique_ptr<ITask> inner;
+    TaskThrottle* throttle = nullptr;
+    TaskType type = TaskType::IO;
+
+    // CPU estimate charged when the task was admitted; corrected after the run.
+    double chargedMs = 0.0;
+
+    void SetErrorCallback(const std::function<void(const std::exception&)>& callback) override
+    {
+        inner->SetErrorCallback(callback);
+    }
+
+    void SetCancellationToken(CancellationToken token) override
+    {
+        inner->SetCancellationToken(std::move(token));
+    }
+
+    bool IsCancelled() const noexcept override
+    {
+        return inner->IsCancelled();
+    }
+
+    void SetTaskType(TaskType t) override
+    {
+        inner->SetTaskType(t);
+    }
+
+    void OnCancelled() override
+    {
+        inner->OnCancelled();
+    }
+
+    inline void operator()() override;
+};
+
+// Per-category rate limiting for ThreadPool submissions.
+//
+// Tasks of a throttled category that exceed their budget are deferred in FIFO
+// order (never dropped) and released by ThreadPool's throttle pump as the
+// budget refills. Unthrottled categories pay a single relaxed load.
+class TaskThrottle
+{
+public:
+    static constexpr size_t CATEGORY_COUNT = 3;
+
+    void SetLimits(TaskType type, const ThrottleLimits& limits)
+    {
+        Category& c = At(type);
+        std::lock_guard<std::mutex> lock(c.mutex);
+        c.limits = limits;
+        c.taskBucket.Configure(limits.tasksPerSecond, limits.burstSeconds);
+        c.cpuBucket.Configure(limits.cpuMsPerSecond, limits.burstSeconds);
+        c.enabled.store(!limits.IsUnlimited(), std::memory_order_release);
+    }
+
+    ThrottleLimits GetLimits(TaskType type)
+    {
+        Category& c = At(type);
+        std::lock_guard<std::mutex> lock(c.mutex);
+        return c.limits;
+    }
+
+    inline bool IsThrottled(TaskType type) const noexcept
+    {
+        return categories_[Index(type)].enabled.load(std::memory_order_relaxed);
+    }
+
+    // Prepares a task for a throttled category: wraps it for CPU accounting
+    // when a CPU budget is set.
+    std::unique_ptr<ITask> Wrap(TaskType type, std::unique_ptr<ITask> task)
+    {
+        Category& c = At(type);
+        {
+            std::lock_guard<std::mutex> lock(c.mutex);
+            if (c.limits.cpuMsPerSecond <= 0.0)
+                return task;
+        }
+
+        auto wrapped = std::make_unique<ThrottledTask>();
+        wrapped->inner = std::move(task);
+        wrapped->throttle = this;
+        wrapped->type = type;
+        return wrapped;
+    }
+
+    // Takes one start token if the category is within budget and nothing is
+    // already waiting ahead of the caller (keeps FIFO order).
+    bool TryAcquire(TaskType type, ITask& task)
+    {
+        Category& c = At(type);
+        std::lock_guard<std::mutex> lock(c.mutex);
+        if (!c.admitted.empty() || !c.deferred.empty())
+            return false;
+        return AcquireLocked(c, task);
+    }
+
+    void Defer(TaskType type, std::unique_ptr<ITask> task)
+    {
+        Category& c = At(type);
+        std::lock_guard<std::mutex> lock(c.mutex);
+        c.deferred.push_back(std::move(task));
+        UpdateCountLocked(c);
+    }
+
+    // Puts a task that already took its budget back at the head of the queue
+    // (used when dispatch failed). It is released before any deferred task and
+    // is not charged again.
+    void Requeue(TaskType type, std::unique_ptr<ITask> task)
+    {
+        Category& c = At(type);
+        std::lock_guard<std::mutex> lock(c.mutex);
+        c.admitted.push_front(std::move(task));
+        UpdateCountLocked(c);
+    }
+
+    // Pops the next waiting task: a requeued one, or a deferred one if the
+    // budget now allows it to start.
+    std::unique_ptr<ITask> TryRelease(TaskType type)
+    {
+        Category& c = At(type);
+        std::lock_guard<std::mutex> lock(c.mutex);
+
+        std::deque<std::unique_ptr<ITask>>* queue = &c.admitted;
+        if (queue->empty())
+        {
+            queue = &c.deferred;
+            if (queue->empty() || !AcquireLocked(c, *queue->front()))
+                return nullptr;
+        }
+
+        auto task = std::move(queue->front());
+        queue->pop_front();
+        UpdateCountLocked(c);
+        return task;
+    }
+
+    // Settles the difference between the admission estimate and the measured
+    // run time, and updates the running estimate for the category.
+    void ChargeCpu(TaskType type, double estimatedMs, double actualMs)
+    {
+        Category& c = At(type);
+        std::lock_guard<std::mutex> lock(c.mutex);
+        c.cpuBucket.Charge(actualMs - estimatedMs);
+        c.avgCpuMs += (actualMs - c.avgCpuMs) * CPU_ESTIMATE_ALPHA;
+    }
+
+    // Removes all deferred tasks (used on shutdown).
+    std::deque<std::unique_ptr<ITask>> TakeAllDeferred(TaskType type)
+    {
+        Category& c = At(type);
+        std::lock_guard<std::mutex> lock(c.mutex);
+        std::deque<std::unique_ptr<ITask>> out;
+        out.swap(c.admitted);
+        std::move(c.deferred.begin(), c.deferred.end(), std::back_inserter(out));
+        c.deferred.clear();
+        UpdateCountLocked(c);
+        return out;
+    }
+
+    size_t GetDeferredCount(TaskType type) const noexcept
+    {
+        return categories_[Index(type)].deferredCount.load(std::memory_order_relaxed);
+    }
+
+    size_t GetTotalDeferred() const noexcept
+    {
+        size_t total = 0;
+        for (const auto& c : categories_)
+            total += c.deferredCount.load(std::memory_order_relaxed);
+        return total;
+    }
+
+private:
+    // Weight of the newest sample in the per-category CPU estimate.
+    static constexpr double CPU_ESTIMATE_ALPHA = 0.125;
+
+    struct Category
+    {
+        std::mutex mutex;
+        ThrottleLimits limits;
+        TokenBucket taskBucket;
+        TokenBucket cpuBucket;
+        double avgCpuMs = 1.0;
+        std::deque<std::unique_ptr<ITask>> admitted; // charged, waiting for queue space
+        std::deque<std::unique_ptr<ITask>> deferred; // waiting for budget
+        std::atomic<bool> enabled{false};
+        std::atomic<size_t> deferredCount{0};
+    };
+
+    static constexpr size_t Index(TaskType type) noexcept
+    {
+        return static_cast<size_t>(type);
+    }
+
+    Category& At(TaskType type) noexcept
+    {
+        return categories_[Index(type)];
+    }
+
+    static void UpdateCountLocked(Category& c) noexcept
+    {
+        c.deferredCount.store(c.admitted.size() + c.deferred.size(), std::memory_order_relaxed);
+    }
+
+    // Tasks already running are charged their estimated cost up front, so a
+    // burst of admissions cannot overshoot the CPU budget before any finishes.
+    static bool AcquireLocked(Category& c, ITask& task)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        c.taskBucket.Refill(now);
+        c.cpuBucket.Refill(now);
+
+        if (!c.taskBucket.HasTokens(1.0) || !c.cpuBucket.HasBudget())
+            return false;
+
+        c.taskBucket.Charge(1.0);
+
+        if (c.limits.cpuMsPerSecond > 0.0)
+        {
+            if (auto* throttled = dynamic_cast<ThrottledTask*>(&task))
+            {
+                throttled->chargedMs = c.avgCpuMs;
+                c.cpuBucket.Charge(c.avgCpuMs);
+            }
+        }
+        return true;
+    }
+
+    std::array<Category, CATEGORY_COUNT> categories_;
+};
+
+inline void ThrottledTask::operator()()
+{
+    const auto start = std::chrono::steady_clock::now();
+    (*inner)();
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    throttle->ChargeCpu(type, chargedMs, ms);
+}
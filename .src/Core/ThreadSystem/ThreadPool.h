@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include <memory>
 #include <thread>
@@ -8,10 +9,16 @@
 #include <shared_mutex>
 #include <atomic>
 #include <functional>
+#include <condition_variable>
+#include <chrono>
 
 #include "ITask.h"
 #include "IDispatchStrategy.h"
 #include "Worker.h"
+#include "TaskThrottle.h"
+#include "TimerWheel.h"
+#include "TaskFactory.h"
+#include "TaskErrorChannel.h"
 
 class ThreadPool
 {
@@ -50,16 +57,120 @@ public:
         strategy_ = std::move(s);
     }
 
+    /// Changes how idle workers wait for work. Applies to running workers
+    /// and to workers created by a later Init().
+    void SetIdlePolicy(WorkerIdlePolicy policy)
+    {
+        idlePolicy_ = policy;
+        for (auto& w : workers_)
+        {
+            if (w) w->SetIdlePolicy(policy);
+        }
+    }
+
+    /// Sets a rate limit for a task category. Tasks over budget are deferred,
+    /// not dropped, and released in FIFO order as the budget refills.
+    /// Pass default ThrottleLimits{} to remove the limit.
+    void SetThrottle(TaskType type, const ThrottleLimits& limits)
+    {
+        throttle_.SetLimits(type, limits);
+        if (!limits.IsUnlimited())
+            StartThrottlePump();
+        throttleCv_.notify_one();
+    }
+
+    ThrottleLimits GetThrottle(TaskType type)
+    {
+        return throttle_.GetLimits(type);
+    }
+
+    /// Number of tasks of `type` waiting for throttle budget.
+    size_t GetDeferredCount(TaskType type) const noexcept
+    {
+        return throttle_.GetDeferredCount(type);
+    }
+
     AddTaskResult AddTask(TaskType type, std::unique_ptr<ITask> task)
     {
-        std::shared_lock lock(strategyMutex_);
-        if (!strategy_)
+        task->SetTaskType(type);
+
+        if (UNLIKELY(throttle_.IsThrottled(type)))
         {
-            return AddTaskResult::QueueFull(std::move(task));
+            return AddThrottledTask(type, std::move(task));
         }
 
-        IWorker& worker = strategy_->SelectWorker(workers_, type);
-        return worker.AddTask(std::move(task));
+        return Dispatch(type, std::move(task));
+    }
+
+    /// Submits `task` to category `type` once `delay` has elapsed.
+    /// Insert and cancel are O(1) (hierarchical timing wheel, 1 ms resolution).
+    TimerHandle AddDelayed(TaskType type, std::chrono::milliseconds delay, std::unique_ptr<ITask> task)
+    {
+        StartTimerThread();
+        TimerHandle handle = timers_.ScheduleOnce(type, ElapsedTicks(), ToTicks(delay), std::move(task));
+        WakeTimerThread();
+        return handle;
+    }
+
+    /// Submits a fresh task running `func` to category `type` every `period`.
+    /// The first run happens after `period` unless `firstDelay` is given.
+    TimerHandle AddPeriodic(TaskType type,
+                            std::chrono::milliseconds period,
+                            std::function<void()> func,
+                            std::function<void(const std::exception&)> errorCallback = nullptr,
+                            std::chrono::milliseconds firstDelay = std::chrono::milliseconds(-1))
+    {
+        StartTimerThread();
+        if (firstDelay.count() < 0)
+            firstDelay = period;
+
+        auto factory = [func = std::move(func), errorCallback = std::move(errorCallback)]()
+        {
+            return TaskFactory::MakeTask(func, errorCallback);
+        };
+
+        TimerHandle handle = timers_.SchedulePeriodic(type, ElapsedTicks(), ToTicks(firstDelay), ToTicks(period),
+                                                      std::move(factory));
+        WakeTimerThread();
+        return handle;
+    }
+
+    /// Cancels a delayed or periodic task. Returns false if it already fired
+    /// (one-shot) or was cancelled before.
+    bool CancelTimer(TimerHandle handle)
+    {
+        return timers_.Cancel(handle);
+    }
+
+    size_t GetPendingTimers() const
+    {
+        return timers_.GetPendingCount();
+    }
+
+    /// Periodically drains TaskErrorChannel into `logger` on the timer thread.
+    /// The drain never goes through a worker queue, so it keeps reporting when
+    /// tasks cannot be dispatched. Pass nullptr to stop draining (errors then
+    /// stay queued / get dropped).
+    void SetErrorLogger(ILogger* logger,
+                        std::chrono::milliseconds interval = std::chrono::milliseconds(250))
+    {
+        {
+            std::lock_guard<std::mutex> lock(timerMutex_);
+            errorLogger_ = logger;
+            errorDrainPeriod_ = std::max<TimerWheel::Tick>(1, ToTicks(interval));
+            nextErrorDrain_ = ElapsedTicks() + errorDrainPeriod_;
+        }
+
+        if (logger)
+        {
+            StartTimerThread();
+            WakeTimerThread();
+        }
+    }
+
+    uint64_t GetErrorCount(TaskType type) const noexcept
+    {
+        return TaskErrorChannel::Instance().GetErrorCount(type);
     }
 
     void Shutdown()
@@ -67,12 +178,23 @@ public:
         // If Init was not called — nothing to stop
         std::call_once(initFlag_, [](){});
 
+        StopTimerThread();
+        StopThrottlePump();
+
         for (auto& w : workers_)
         {
             if (w) w->Stop();
         }
 
         workers_.clear();
+
+        // Flush errors raised by the last tasks. The logger is not used again:
+        // it may be destroyed before the pool during static destruction.
+        if (errorLogger_)
+        {
+            TaskErrorChannel::Instance().DrainTo(*errorLogger_);
+            errorLogger_ = nullptr;
+        }
     }
 
     const std::vector<std::unique_ptr<IWorker>>& GetWorkers() const noexcept
@@ -86,7 +208,11 @@ public:
     }
 
 private:
-    ThreadPool() = default;
+    ThreadPool()
+    {
+        // Construct the error channel first so it outlives the pool.
+        TaskErrorChannel::Instance();
+    }
 
     ~ThreadPool()
     {
@@ -106,6 +232,252 @@ private:
         return (n > 1) ? static_cast<unsigned short>(n - 1) : 1;
     }
 
+    // Takes `task` by reference: if the strategy throws, the caller still owns it.
+    AddTaskResult Dispatch(TaskType type, std::unique_ptr<ITask>&& task)
+    {
+        std::shared_lock lock(strategyMutex_);
+        if (!strategy_)
+        {
+            return AddTaskResult::QueueFull(std::move(task));
+        }
+
+        IWorker& worker = strategy_->SelectWorker(workers_, type);
+        return worker.AddTask(std::move(task));
+    }
+
+    AddTaskResult AddThrottledTask(TaskType type, std::unique_ptr<ITask> task)
+    {
+        task = throttle_.Wrap(type, std::move(task));
+
+        if (throttle_.TryAcquire(type, *task))
+        {
+            AddTaskResult res = Dispatch(type, std::move(task));
+            if (res)
+                return res;
+
+            // Already charged: hand it to the pump instead of back to the caller,
+            // whose retry would pay for it a second time.
+            throttle_.Requeue(type, std::move(res.task));
+        }
+        else
+        {
+            throttle_.Defer(type, std::move(task));
+        }
+        {
+            // Pairs with the predicate check in ThrottlePumpLoop (no lost wake-up).
+            std::lock_guard<std::mutex> lock(throttleMutex_);
+        }
+        throttleCv_.notify_one();
+        return AddTaskResult::Ok();
+    }
+
+    void StartThrottlePump()
+    {
+        std::lock_guard<std::mutex> lock(throttleMutex_);
+        if (throttleThread_.joinable())
+            return;
+
+        throttleStop_ = false;
+        throttleThread_ = std::thread(&ThreadPool::ThrottlePumpLoop, this);
+    }
+
+    void StopThrottlePump()
+    {
+        {
+            std::lock_guard<std::mutex> lock(throttleMutex_);
+            throttleStop_ = true;
+        }
+        throttleCv_.notify_one();
+
+        if (throttleThread_.joinable())
+            throttleThread_.join();
+
+        // Deferred tasks will never run: let futures observe it.
+        for (size_t i = 0; i < TaskThrottle::CATEGORY_COUNT; ++i)
+        {
+            for (auto& task : throttle_.TakeAllDeferred(static_cast<TaskType>(i)))
+                task->OnCancelled();
+        }
+    }
+
+    // Releases deferred tasks as their categories regain budget.
+    void ThrottlePumpLoop()
+    {
+        std::unique_lock<std::mutex> lock(throttleMutex_);
+
+        while (!throttleStop_)
+        {
+            if (throttle_.GetTotalDeferred() == 0)
+            {
+                throttleCv_.wait(lock, [&]
+                                 { return throttleStop_ || throttle_.GetTotalDeferred() > 0; });
+                continue;
+            }
+
+            lock.unlock();
+            for (size_t i = 0; i < TaskThrottle::CATEGORY_COUNT; ++i)
+            {
+                const auto type = static_cast<TaskType>(i);
+                while (auto task = throttle_.TryRelease(type))
+                {
+                    AddTaskResult res;
+                    try
+                    {
+                        res = Dispatch(type, std::move(task));
+                    }
+                    catch (...)
+                    {
+                        // The strategy refused the category (e.g. too few workers). The
+                        // task is already charged: keep it first in line for the next
+                        // round and report it; an escape here would terminate.
+                        TaskErrorChannel::Instance().Report(std::current_exception(), type, "Throttle");
+                        throttle_.Requeue(type, std::move(task));
+                        break;
+                    }
+
+                    if (!res)
+                    {
+                        throttle_.Requeue(type, std::move(res.task));
+                        break;
+                    }
+                }
+            }
+            lock.lock();
+
+            throttleCv_.wait_for(lock, THROTTLE_PUMP_INTERVAL, [&]
+                                 { return throttleStop_; });
+        }
+    }
+
+    static TimerWheel::Tick ToTicks(std::chrono::milliseconds ms) noexcept
+    {
+        return ms.count() > 0 ? static_cast<TimerWheel::Tick>(ms.count()) : 0;
+    }
+
+    TimerWheel::Tick ElapsedTicks() const noexcept
+    {
+        auto elapsed = std::chrono::steady_clock::now() - timerEpoch_;
+        return static_cast<TimerWheel::Tick>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+    }
+
+    void StartTimerThread()
+    {
+        std::lock_guard<std::mutex> lock(timerMutex_);
+        if (timerThread_.joinable())
+            return;
+
+        timerStop_ = false;
+        timerThread_ = std::thread(&ThreadPool::TimerLoop, this);
+    }
+
+    void WakeTimerThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(timerMutex_);
+            timerDirty_ = true;
+        }
+        timerCv_.notify_one();
+    }
+
+    void StopTimerThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(timerMutex_);
+            timerStop_ = true;
+        }
+        timerCv_.notify_one();
+
+        if (timerThread_.joinable())
+            timerThread_.join();
+
+        for (auto& task : timers_.Clear())
+            task->OnCancelled();
+    }
+
+    // Single timer thread: advances the wheel and submits due tasks.
+    // Sleeps until the next occupied slot instead of waking every tick.
+    void TimerLoop()
+    {
+        std::vector<ExpiredTimer> expired;
+        std::unique_lock<std::mutex> lock(timerMutex_);
+
+        while (!timerStop_)
+        {
+            ILogger* errorLogger = nullptr;
+            if (errorLogger_ && ElapsedTicks() >= nextErrorDrain_)
+            {
+                errorLogger = errorLogger_;
+                nextErrorDrain_ = ElapsedTicks() + errorDrainPeriod_;
+            }
+
+            lock.unlock();
+
+            if (errorLogger)
+                DrainErrors(*errorLogger);
+
+            expired.clear();
+            timers_.Advance(ElapsedTicks(), expired);
+
+            for (auto& e : expired)
+            {
+                if (!e.task)
+                    continue;
+
+                try
+                {
+                    AddTaskResult res = AddTask(e.type, std::move(e.task));
+                    if (!res)
+                    {
+                        // Queue full: retry on the next tick rather than losing the task.
+                        timers_.ScheduleOnce(e.type, ElapsedTicks(), 1, std::move(res.task));
+                    }
+                }
+                catch (...)
+                {
+                    // The strategy refused the category (e.g. too few workers): drop
+                    // this firing and report it; an escape here would terminate.
+                    TaskErrorChannel::Instance().Report(std::current_exception(), e.type, "Timer");
+                }
+            }
+
+            TimerWheel::Tick wait = timers_.TicksUntilNextEvent();
+            lock.lock();
+
+            if (errorLogger_)
+            {
+                const TimerWheel::Tick now = ElapsedTicks();
+                wait = std::min(wait, nextErrorDrain_ > now ? nextErrorDrain_ - now : 0);
+            }
+
+            if (timerDirty_)
+            {
+                timerDirty_ = false;
+                continue;
+            }
+
+            auto pred = [&] { return timerStop_ || timerDirty_; };
+            if (wait == UINT64_MAX)
+                timerCv_.wait(lock, pred);
+            else
+                timerCv_.wait_for(lock, std::chrono::milliseconds(wait), pred);
+        }
+    }
+
+    static void DrainErrors(ILogger& logger) noexcept
+    {
+        try
+        {
+            auto& channel = TaskErrorChannel::Instance();
+            if (channel.HasPending())
+                channel.DrainTo(logger);
+        }
+        catch (...)
+        {
+            // Logging failed (e.g. out of memory); the errors are lost, the timer thread is not.
+        }
+    }
+
     void InitWorkers(int count)
     {
         if (count < 1)
@@ -125,6 +497,7 @@ private:
         {
             size_t core = (i < cpuCount) ? i : (i % cpuCount);
             workers_[i]->SetAffinityIndex(core);
+            workers_[i]->SetIdlePolicy(idlePolicy_);
             workers_[i]->Start();
         }
 
@@ -139,6 +512,28 @@ private:
 
     short countOfWorkers_ = -1;
     size_t workerQueueSize_ = 4096;
+    WorkerIdlePolicy idlePolicy_ = WorkerIdlePolicy::SpinYieldSleep;
 
     std::once_flag initFlag_;
+
+    static constexpr std::chrono::milliseconds THROTTLE_PUMP_INTERVAL{2};
+
+    TaskThrottle throttle_;
+    std::thread throttleThread_;
+    std::mutex throttleMutex_;
+    std::condition_variable throttleCv_;
+    bool throttleStop_ = false;
+
+    TimerWheel timers_;
+    const std::chrono::steady_clock::time_point timerEpoch_ = std::chrono::steady_clock::now();
+    std::thread timerThread_;
+    std::mutex timerMutex_;
+    std::condition_variable timerCv_;
+    bool timerStop_ = false;
+    bool timerDirty_ = false;
+
+    // Error drain, run by the timer thread; guarded by timerMutex_.
+    ILogger* errorLogger_ = nullptr;
+    TimerWheel::Tick errorDrainPeriod_ = 250;
+    TimerWheel::Tick nextErrorDrain_ = 0;
 };
\ No newline at end of file
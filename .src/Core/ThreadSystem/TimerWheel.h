@@ -0,0 +1,352 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ITask.h"
+#include "TaskType.h"
+
+// Identifies a scheduled timer. Stale handles (timer already fired or
+// cancelled) are detected through the generation counter.
+struct TimerHandle
+{
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool IsValid() const noexcept { return index != UINT32_MAX; }
+};
+
+// A timer that became due: what to submit and to which category.
+struct ExpiredTimer
+{
+    TaskType type;
+    std::unique_ptr<ITask> task;
+};
+
+// Hierarchical timing wheel (Varghese & Lauck) with 1 ms ticks.
+//
+// 4 levels x 256 slots cover 2^32 ticks (~49 days). Timers live in a node
+// pool and are linked into slots by index, so insert and cancel are O(1)
+// and there is no allocation per timer once the pool has grown.
+// Far-away timers are cascaded down one level each time the level below wraps.
+//
+// Thread-safe: all operations take one internal mutex.
+class TimerWheel
+{
+public:
+    using Tick = uint64_t;
+
+    static constexpr size_t LEVELS = 4;
+    static constexpr size_t SLOT_BITS = 8;
+    static constexpr size_t SLOTS = size_t{1} << SLOT_BITS;
+    static constexpr size_t SLOT_MASK = SLOTS - 1;
+
+    TimerWheel()
+    {
+        for (auto& level : slots_)
+            level.fill(NIL);
+    }
+
+    // One-shot timer: `task` is submitted once, `delay` ticks after `now`.
+    //
+    // `now` is the driver's clock, the same one it passes to Advance(). The
+    // wheel only moves when it is advanced, so after an idle period its own
+    // position lags behind and must not be used as the start of the delay.
+    TimerHandle ScheduleOnce(TaskType type, Tick now, Tick delay, std::unique_ptr<ITask> task)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t idx = AllocNode();
+        Node& n = nodes_[idx];
+        n.type = type;
+        n.task = std::move(task);
+        n.period = 0;
+        n.expiry = std::max(current_, now) + std::max<Tick>(delay, 1);
+        Link(idx);
+        return {idx, n.generation};
+    }
+
+    // Periodic timer: `factory` builds a fresh task every `period` ticks,
+    // starting `firstDelay` ticks after `now` (see ScheduleOnce). Re-armed
+    // relative to its previous deadline, so it does not drift.
+    TimerHandle SchedulePeriodic(TaskType type, Tick now, Tick firstDelay, Tick period,
+                                 std::function<std::unique_ptr<ITask>()> factory)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t idx = AllocNode();
+        Node& n = nodes_[idx];
+        n.type = type;
+        n.factory = std::move(factory);
+        n.period = std::max<Tick>(period, 1);
+        n.expiry = std::max(current_, now) + std::max<Tick>(firstDelay, 1);
+        Link(idx);
+        return {idx, n.generation};
+    }
+
+    // Removes a pending timer. Returns false if it already fired or was cancelled.
+    // A one-shot task removed this way gets OnCancelled().
+    bool Cancel(TimerHandle handle)
+    {
+        std::unique_ptr<ITask> task;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!IsLive(handle))
+                return false;
+
+            Unlink(handle.index);
+            task = std::move(nodes_[handle.index].task);
+            FreeNode(handle.index);
+        }
+
+        if (task)
+            task->OnCancelled();
+        return true;
+    }
+
+    // Advances the wheel to `now` and moves every due timer into `out`.
+    void Advance(Tick now, std::vector<ExpiredTimer>& out)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Nothing to fire or cascade: jump instead of stepping through an idle period.
+        if (pending_ == 0 && current_ < now)
+            current_ = now;
+
+        while (current_ < now)
+        {
+            ++current_;
+
+            // Cascade higher levels whenever the level below wraps around.
+            for (size_t level = 1; level < LEVELS; ++level)
+            {
+                if ((current_ & ((Tick{1} << (SLOT_BITS * level)) - 1)) != 0)
+                    break;
+                Cascade(level, (current_ >> (SLOT_BITS * level)) & SLOT_MASK);
+            }
+
+            const size_t slot = current_ & SLOT_MASK;
+            uint32_t idx = TakeSlot(0, slot);
+            while (idx != NIL)
+            {
+                const uint32_t next = nodes_[idx].next;
+                Fire(idx, out);
+                idx = next;
+            }
+        }
+    }
+
+    // Ticks until the next level-0 slot that holds a timer, capped at the next
+    // cascade point. Lets the driver sleep instead of polling every tick.
+    Tick TicksUntilNextEvent() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_ == 0)
+            return UINT64_MAX;
+
+        const size_t base = current_ & SLOT_MASK;
+        const Tick untilWrap = SLOTS - base;
+        for (Tick d = 1; d <= untilWrap; ++d)
+        {
+            const size_t slot = (base + d) & SLOT_MASK;
+            if (IsOccupied(0, slot))
+                return d;
+        }
+        return untilWrap;
+    }
+
+    Tick GetCurrentTick() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return current_;
+    }
+
+    size_t GetPendingCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pending_;
+    }
+
+    // Removes every pending timer (used on shutdown).
+    std::vector<std::unique_ptr<ITask>> Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::unique_ptr<ITask>> tasks;
+        for (uint32_t i = 0; i < nodes_.size(); ++i)
+        {
+            if (!nodes_[i].linked)
+                continue;
+            Unlink(i);
+            if (nodes_[i].task)
+                tasks.push_back(std::move(nodes_[i].task));
+            FreeNode(i);
+        }
+        return tasks;
+    }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Node
+    {
+        Tick expiry = 0;
+        Tick period = 0; // 0 = one-shot
+        uint32_t prev = NIL;
+        uint32_t next = NIL;
+        uint32_t generation = 0;
+        uint8_t level = 0;
+        uint16_t slot = 0;
+        bool linked = false;
+        TaskType type = TaskType::Light;
+        std::unique_ptr<ITask> task;
+        std::function<std::unique_ptr<ITask>()> factory;
+    };
+
+    uint32_t AllocNode()
+    {
+        if (freeHead_ != NIL)
+        {
+            uint32_t idx = freeHead_;
+            freeHead_ = nodes_[idx].next;
+            nodes_[idx].next = NIL;
+            return idx;
+        }
+        nodes_.emplace_back();
+        return static_cast<uint32_t>(nodes_.size() - 1);
+    }
+
+    void FreeNode(uint32_t idx)
+    {
+        Node& n = nodes_[idx];
+        n.task.reset();
+        n.factory = nullptr;
+        ++n.generation;
+        n.prev = NIL;
+        n.next = freeHead_;
+        freeHead_ = idx;
+    }
+
+    bool IsLive(TimerHandle h) const noexcept
+    {
+        return h.index < nodes_.size()
+            && nodes_[h.index].generation == h.generation
+            && nodes_[h.index].linked;
+    }
+
+    bool IsOccupied(size_t level, size_t slot) const noexcept
+    {
+        return (occupied_[level][slot >> 6] >> (slot & 63)) & 1u;
+    }
+
+    void Link(uint32_t idx)
+    {
+        Node& n = nodes_[idx];
+        const Tick delta = n.expiry > current_ ? n.expiry - current_ : 1;
+
+        size_t level = 0;
+        while (level + 1 < LEVELS && delta >= (Tick{1} << (SLOT_BITS * (level + 1))))
+            ++level;
+
+        // Beyond the wheel's range: park in the last slot of the top level,
+        // it will be cascaded again and re-evaluated.
+        Tick at = n.expiry;
+        if (delta >= (Tick{1} << (SLOT_BITS * LEVELS)))
+            at = current_ + (Tick{1} << (SLOT_BITS * LEVELS)) - 1;
+
+        const size_t slot = (at >> (SLOT_BITS * level)) & SLOT_MASK;
+
+        n.level = static_cast<uint8_t>(level);
+        n.slot = static_cast<uint16_t>(slot);
+        n.prev = NIL;
+        n.next = slots_[level][slot];
+        if (n.next != NIL)
+            nodes_[n.next].prev = idx;
+        slots_[level][slot] = idx;
+        occupied_[level][slot >> 6] |= (uint64_t{1} << (slot & 63));
+        n.linked = true;
+        ++pending_;
+    }
+
+    void Unlink(uint32_t idx)
+    {
+        Node& n = nodes_[idx];
+        if (n.prev != NIL)
+            nodes_[n.prev].next = n.next;
+        else
+            slots_[n.level][n.slot] = n.next;
+
+        if (n.next != NIL)
+            nodes_[n.next].prev = n.prev;
+
+        if (slots_[n.level][n.slot] == NIL)
+            occupied_[n.level][n.slot >> 6] &= ~(uint64_t{1} << (n.slot & 63));
+
+        n.prev = NIL;
+        n.next = NIL;
+        n.linked = false;
+        --pending_;
+    }
+
+    // Detaches a whole slot list; nodes keep their `next` links for iteration.
+    uint32_t TakeSlot(size_t level, size_t slot)
+    {
+        uint32_t head = slots_[level][slot];
+        slots_[level][slot] = NIL;
+        occupied_[level][slot >> 6] &= ~(uint64_t{1} << (slot & 63));
+
+        for (uint32_t i = head; i != NIL; i = nodes_[i].next)
+        {
+            nodes_[i].linked = false;
+            --pending_;
+        }
+        return head;
+    }
+
+    void Cascade(size_t level, size_t slot)
+    {
+        uint32_t idx = TakeSlot(level, slot);
+        while (idx != NIL)
+        {
+            const uint32_t next = nodes_[idx].next;
+            Link(idx);
+            idx = next;
+        }
+    }
+
+    void Fire(uint32_t idx, std::vector<ExpiredTimer>& out)
+    {
+        Node& n = nodes_[idx];
+
+        if (n.expiry > current_)
+        {
+            // Parked out-of-range timer reached level 0 early: re-insert.
+            Link(idx);
+            return;
+        }
+
+        if (n.period == 0)
+        {
+            out.push_back({n.type, std::move(n.task)});
+            FreeNode(idx);
+            return;
+        }
+
+        out.push_back({n.type, n.factory()});
+        n.expiry += n.period;
+        if (n.expiry <= current_)
+            n.expiry = current_ + n.period; // fell behind: skip missed periods
+        Link(idx);
+    }
+
+    mutable std::mutex mutex_;
+    Tick current_ = 0;
+    size_t pending_ = 0;
+    uint32_t freeHead_ = NIL;
+    std::vector<Node> nodes_;
+    std::array<std::array<uint32_t, SLOTS>, LEVELS> slots_;
+    std::array<std::array<uint64_t, SLOTS / 64>, LEVELS> occupied_{};
+};
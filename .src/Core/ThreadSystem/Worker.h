@@ -14,6 +14,7 @@
 #include "ITask.h"
 #include "IWorker.h"
 #include "WorkerConfig.h"
+#include "WorkerIdlePolicy.h"
 
 class ThreadPool;
 
@@ -42,12 +43,16 @@ private:
 #endif
     alignas(CACHE_LINE_SIZE) std::array<char, CACHE_LINE_SIZE> pad_executed_{};
 
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> cancelledTasks{0};
+
     alignas(CACHE_LINE_SIZE) std::atomic<size_t> queueCount{0};
     alignas(CACHE_LINE_SIZE) std::array<char, CACHE_LINE_SIZE> pad_queuecount_{};
 
     alignas(CACHE_LINE_SIZE) std::atomic<WorkerStatus> status_{WorkerStatus::Running};
     alignas(CACHE_LINE_SIZE) std::array<char, CACHE_LINE_SIZE> pad_status_{};
 
+    std::atomic<WorkerIdlePolicy> idlePolicy_{WorkerIdlePolicy::SpinYieldSleep};
+
     std::condition_variable cv;
     std::mutex cvMtx;
 
@@ -94,6 +99,28 @@ public:
         return queueCount.load(std::memory_order_relaxed) > 0;
     }
 
+    inline WorkerIdlePolicy GetIdlePolicy() const noexcept
+    {
+        return idlePolicy_.load(std::memory_order_relaxed);
+    }
+
+    // Runs a dequeued task, or skips it if it was cancelled while queued.
+    // Returns 1 if the task ran, 0 if it was skipped (counted as cancelled).
+    inline size_t Execute(ITask& task)
+    {
+        if (UNLIKELY(task.IsCancelled()))
+        {
+            task.OnCancelled();
+#if WORKER_ENABLE_STATS
+            cancelledTasks.fetch_add(1, std::memory_order_relaxed);
+#endif
+            return 0;
+        }
+
+        task(); // No try/catch → Task handles errors internally
+        return 1;
+    }
+
     inline void NotifyOneLocked() noexcept
     {
         cv.notify_one();
@@ -105,6 +132,13 @@ public:
         coreIndex = idx;
     }
 
+    inline void SetIdlePolicy(WorkerIdlePolicy policy) noexcept override
+    {
+        idlePolicy_.store(policy, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lk(cvMtx);
+        cv.notify_one();
+    }
+
     void Start() override
     {
         thread = std::thread(&Worker::Run, this);
@@ -163,13 +197,16 @@ public:
                 {
                     queueCount.fetch_sub(got, std::memory_order_relaxed);
 
+                    size_t ran = 0;
                     for (size_t i = 0; i < got; ++i)
                     {
-                        (*batch[i])(); // No try/catch → Task handles errors internally
+                        ran += Execute(*batch[i]);
                     }
 
 #if WORKER_ENABLE_STATS
-                    executedTasks.fetch_add(got, std::memory_order_relaxed);
+                    executedTasks.fetch_add(ran, std::memory_order_relaxed);
+#else
+                    (void)ran;
 #endif
                     lock.lock();
                     continue;
@@ -179,7 +216,13 @@ public:
                 std::unique_ptr<ITask> task;
                 bool gotSingle = false;
 
-                for (int spin = 0; spin < SPIN_TRIES; ++spin)
+                const WorkerIdlePolicy policy = GetIdlePolicy();
+                const int spinTries =
+                    (policy == WorkerIdlePolicy::SpinYieldSleep || policy == WorkerIdlePolicy::BusySpin) ? SPIN_TRIES : 0;
+                const int yieldTries =
+                    (policy == WorkerIdlePolicy::Sleep) ? 0 : YIELD_TRIES;
+
+                for (int spin = 0; spin < spinTries; ++spin)
                 {
                     if (tasks.try_dequeue(task))
                     {
@@ -192,7 +235,7 @@ public:
                 // ----------------- 3. YIELD TRY SINGLE -----------------
                 if (!gotSingle)
                 {
-                    for (int y = 0; y < YIELD_TRIES; ++y)
+                    for (int y = 0; y < yieldTries; ++y)
                     {
                         if (tasks.try_dequeue(task))
                         {
@@ -207,20 +250,22 @@ public:
                 if (!gotSingle)
                 {
                     lock.lock();
-                    if (!HasTasks() && !IsStopped())
+                    if (policy != WorkerIdlePolicy::BusySpin && !HasTasks() && !IsStopped())
                     {
                         cv.wait(lock, [&]
-                                { return IsStopped() || HasTasks() || !IsPaused(); });
+                                { return IsStopped() || HasTasks() || IsPaused() || GetIdlePolicy() != policy; });
                     }
                     continue;
                 }
 
                 // ----------------- 5. EXECUTE ONE -----------------
                 queueCount.fetch_sub(1, std::memory_order_relaxed);
-                (*task)(); // no try/catch
+                const size_t ran = Execute(*task);
 
 #if WORKER_ENABLE_STATS
-                executedTasks.fetch_add(1, std::memory_order_relaxed);
+                executedTasks.fetch_add(ran, std::memory_order_relaxed);
+#else
+                (void)ran;
 #endif
 
                 lock.lock();
@@ -271,7 +316,9 @@ public:
 
 #if WORKER_ENABLE_STATS
     inline uint64_t GetExecutedTasks() const noexcept { return executedTasks.load(std::memory_order_relaxed); }
+    inline uint64_t GetCancelledTasks() const noexcept override { return cancelledTasks.load(std::memory_order_relaxed); }
 #else
     inline uint64_t GetExecutedTasks() const noexcept { return 0; }
+    inline uint64_t GetCancelledTasks() const noexcept override { return 0; }
 #endif
 };
\ No newline at end of file
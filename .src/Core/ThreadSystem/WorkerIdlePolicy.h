@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+// Controls what a worker does when its queue runs dry.
+// Trades wake-up latency against CPU burn while idle.
+enum class WorkerIdlePolicy : uint8_t
+{
+    // Spin, then yield, then sleep on the condition variable (default).
+    SpinYieldSleep,
+
+    // Skip spinning: yield a few times, then sleep.
+    YieldSleep,
+
+    // Sleep on the condition variable immediately.
+    // Lowest CPU usage, highest wake-up latency.
+    Sleep,
+
+    // Never sleep: keep spinning and yielding until work arrives.
+    // Lowest latency, burns a full core per idle worker.
+    BusySpin
+};
+
+inline const char* ToString(WorkerIdlePolicy policy) noexcept
+{
+    switch (policy)
+    {
+        case WorkerIdlePolicy::SpinYieldSleep: return "spin_yield_sleep";
+        case WorkerIdlePolicy::YieldSleep:     return "yield_sleep";
+        case WorkerIdlePolicy::Sleep:          return "sleep";
+        case WorkerIdlePolicy::BusySpin:       return "busy_spin";
+        default:                               return "unknown";
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Cheap wall-clock timestamps for logging and telemetry.
+ *
+ * Formatting a time point normally costs a localtime call and a stream per
+ * message. Here each thread caches the formatted "HH:MM:SS" (and date) of the
+ * last second it saw; within that second only the microsecond digits are
+ * written, by hand. localtime runs at most once per second per thread, so
+ * timezone and DST changes are still picked up.
+ */
+class TimestampService {
+public:
+    using Clock = std::chrono::system_clock;
+
+    /// Length of "HH:MM:SS.uuuuuu".
+    static constexpr size_t TIME_LENGTH = 15;
+
+    /// Length of "YYYY-MM-DD HH:MM:SS.uuuuuu".
+    static constexpr size_t DATE_TIME_LENGTH = 26;
+
+    /** @brief Wall-clock time to stamp a record with (vDSO / precise file time, no syscall). */
+    static Clock::time_point Now() noexcept { return Clock::now(); }
+
+    /** @brief Monotonic microseconds, for measuring durations in traces. */
+    static uint64_t MonotonicMicros() noexcept {
+        using namespace std::chrono;
+        return static_cast<uint64_t>(
+            duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    /** @brief Writes "HH:MM:SS.uuuuuu" (local time) to @p out, which must hold TIME_LENGTH chars. */
+    static void FormatTime(Clock::time_point time, char* out) noexcept;
+
+    /** @brief Writes "YYYY-MM-DD HH:MM:SS.uuuuuu" to @p out, which must hold DATE_TIME_LENGTH chars. */
+    static void FormatDateTime(Clock::time_point time, char* out) noexcept;
+
+    static void AppendTime(std::string& out, Clock::time_point time);
+    static void AppendDateTime(std::string& out, Clock::time_point time);
+
+    static std::string TimeString(Clock::time_point time);
+};
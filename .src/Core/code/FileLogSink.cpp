@@ -0,0 +1,115 @@
+#include "FileLogSink.h"
+
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "LogArchiver.h"
+
+FileLogSink::FileLogSink(LogLevel level)
+    : LogSinkBase("file", level) {}
+
+FileLogSink::~FileLogSink() {
+    if (m_file.is_open())
+        m_file.close();
+}
+
+bool FileLogSink::Open(const std::string& folderPath) {
+    m_logFolder = folderPath;
+    OpenLogFile();
+    return m_file.is_open();
+}
+
+// Opens a fresh log_<timestamp>.txt in m_logFolder.
+void FileLogSink::OpenLogFile() {
+    using namespace std::chrono;
+    auto now = system_clock::now();
+    auto time = system_clock::to_time_t(now);
+
+    std::tm tm {};
+#ifdef _WIN32
+    localtime_s(&tm, &time);
+#else
+    localtime_r(&time, &tm);
+#endif
+
+    // Формируем имя файла: log_YYYY-MM-DD_HH-MM-SS.txt
+    std::ostringstream stamp;
+    stamp << std::put_time(&tm, "%Y-%m-%d_%H-%M-%S");
+
+    // Полный путь: folderPath + имя файла
+    std::string folder = m_logFolder;
+    if (!folder.empty() && (folder.back() != '/' && folder.back() != '\\'))
+        folder += "\\";
+
+    // Rotation can happen more than once per second: number the files instead
+    // of reusing a name that was rotated out (and maybe already archived).
+    if (stamp.str() == m_fileStamp) {
+        ++m_fileSequence;
+    } else {
+        m_fileStamp = stamp.str();
+        m_fileSequence = 0;
+    }
+
+    m_filePath = folder + "log_" + m_fileStamp + ".txt";
+    while (m_fileSequence > 0 || std::filesystem::exists(m_filePath)) {
+        m_filePath = folder + "log_" + m_fileStamp + "_" + std::to_string(m_fileSequence) + ".txt";
+        if (!std::filesystem::exists(m_filePath))
+            break;
+        ++m_fileSequence;
+    }
+
+    if (m_file.is_open())
+        m_file.close();
+
+    m_file.open(m_filePath, std::ios::app);
+    if (!m_file)
+        std::cerr << "[Logger] Failed to open log file: " << m_filePath << std::endl;
+
+    m_fileBytes = 0;
+    m_fileOpened = steady_clock::now();
+    if (m_archiver)
+        m_archiver->SetActiveFile(m_filePath);
+}
+
+void FileLogSink::EnableRotation(const LogRotationConfig& config) {
+    m_rotation = config;
+    m_archiver = std::make_unique<LogArchiver>(m_logFolder, config);
+    m_archiver->SetActiveFile(m_filePath);
+    m_archiver->Sweep();
+}
+
+std::unique_ptr<LogArchiver> FileLogSink::DetachArchiver() {
+    return std::move(m_archiver);
+}
+
+void FileLogSink::WriteBuffer(std::string_view data) {
+    if (!m_file.is_open())
+        return;
+    m_file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    m_fileBytes += data.size();
+    RotateIfNeeded();
+}
+
+void FileLogSink::Flush() {
+    if (m_file.is_open())
+        m_file.flush();
+}
+
+// Switches to a new file once the active one is too big or too old and
+// hands the closed file to the archiver.
+void FileLogSink::RotateIfNeeded() {
+    if (!m_archiver || !m_file.is_open())
+        return;
+
+    const bool tooBig = m_rotation.maxFileBytes > 0 && m_fileBytes >= m_rotation.maxFileBytes;
+    const bool tooOld = m_rotation.maxFileAge.count() > 0
+        && std::chrono::steady_clock::now() - m_fileOpened >= m_rotation.maxFileAge;
+    if (!tooBig && !tooOld)
+        return;
+
+    const std::string closed = m_filePath;
+    OpenLogFile();
+    m_archiver->Archive(closed);
+}
@@ -0,0 +1,249 @@
+#include "FileWatcher.h"
+
+#include <algorithm>
+#include <array>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // How often the watcher thread wakes up to check the stop flag and flush
+    // debounced changes when no event arrives.
+    constexpr int POLL_INTERVAL_MS = 50;
+}
+
+FileWatcher::~FileWatcher() {
+    Stop();
+}
+
+void FileWatcher::Record(const std::filesystem::path& path, ChangeKind kind) {
+    const auto now = std::chrono::steady_clock::now();
+    auto it = std::find_if(m_pending.begin(), m_pending.end(),
+                           [&](const Pending& p) { return p.path == path; });
+    if (it != m_pending.end()) {
+        it->kind = kind; // the last event wins: write-then-delete is a removal
+        it->last = now;
+    } else {
+        m_pending.push_back({path, kind, now});
+    }
+}
+
+void FileWatcher::EmitQuiet() {
+    if (m_pending.empty())
+        return;
+
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<Change> batch;
+    auto quiet = [&](const Pending& p) { return now - p.last >= m_debounce; };
+
+    for (const Pending& p : m_pending) {
+        if (quiet(p))
+            batch.push_back({p.path, p.kind});
+    }
+    if (batch.empty())
+        return;
+
+    m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(), quiet), m_pending.end());
+    m_callback(batch);
+}
+
+#ifdef _WIN32
+
+bool FileWatcher::Start(const std::vector<std::filesystem::path>& folders,
+                        Callback callback,
+                        std::chrono::milliseconds debounce) {
+    Stop();
+
+    for (const auto& folder : folders) {
+        HANDLE dir = CreateFileW(folder.c_str(), FILE_LIST_DIRECTORY,
+                                 FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                 OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        if (dir == INVALID_HANDLE_VALUE)
+            continue;
+        m_handles.push_back(dir);
+        m_folders.push_back(folder);
+    }
+
+    if (m_handles.empty())
+        return false;
+
+    m_callback = std::move(callback);
+    m_debounce = debounce;
+    m_stop = false;
+    m_running = true;
+    m_thread = std::thread(&FileWatcher::Run, this);
+    return true;
+}
+
+void FileWatcher::Run() {
+    constexpr DWORD FILTER = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+
+    struct Watch {
+        OVERLAPPED overlapped{};
+        alignas(DWORD) std::array<std::byte, 32 * 1024> buffer;
+    };
+
+    const size_t count = m_handles.size();
+    std::vector<Watch> watches(count);
+    std::vector<HANDLE> events(count);
+
+    auto issue = [&](size_t i) {
+        ReadDirectoryChangesW(m_handles[i], watches[i].buffer.data(), static_cast<DWORD>(watches[i].buffer.size()),
+                              FALSE, FILTER, nullptr, &watches[i].overlapped, nullptr);
+    };
+
+    for (size_t i = 0; i < count; ++i) {
+        events[i] = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        watches[i].overlapped.hEvent = events[i];
+        issue(i);
+    }
+
+    while (!m_stop.load(std::memory_order_relaxed)) {
+        const DWORD result = WaitForMultipleObjects(static_cast<DWORD>(count), events.data(), FALSE, POLL_INTERVAL_MS);
+
+        if (result >= WAIT_OBJECT_0 && result < WAIT_OBJECT_0 + count) {
+            const size_t i = result - WAIT_OBJECT_0;
+            DWORD bytes = 0;
+            if (GetOverlappedResult(m_handles[i], &watches[i].overlapped, &bytes, FALSE) && bytes > 0) {
+                const std::byte* p = watches[i].buffer.data();
+                while (true) {
+                    const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(p);
+                    const std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+                    const bool removed = info->Action == FILE_ACTION_REMOVED ||
+                                         info->Action == FILE_ACTION_RENAMED_OLD_NAME;
+                    Record(m_folders[i] / name, removed ? ChangeKind::Removed : ChangeKind::Modified);
+
+                    if (info->NextEntryOffset == 0)
+                        break;
+                    p += info->NextEntryOffset;
+                }
+            }
+            ResetEvent(events[i]);
+            issue(i);
+        }
+
+        EmitQuiet();
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        CancelIoEx(m_handles[i], &watches[i].overlapped);
+        DWORD bytes = 0;
+        GetOverlappedResult(m_handles[i], &watches[i].overlapped, &bytes, TRUE);
+        CloseHandle(events[i]);
+    }
+}
+
+void FileWatcher::Stop() {
+    m_stop = true;
+    if (m_thread.joinable())
+        m_thread.join();
+
+    for (void* handle : m_handles)
+        CloseHandle(handle);
+    m_handles.clear();
+    m_folders.clear();
+    m_pending.clear();
+    m_running = false;
+}
+
+#elif defined(__linux__)
+
+bool FileWatcher::Start(const std::vector<std::filesystem::path>& folders,
+                        Callback callback,
+                        std::chrono::milliseconds debounce) {
+    Stop();
+
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0)
+        return false;
+
+    constexpr uint32_t MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_CREATE;
+    for (const auto& folder : folders) {
+        const int wd = inotify_add_watch(m_fd, folder.c_str(), MASK);
+        if (wd < 0)
+            continue;
+        m_watches.push_back(wd);
+        m_folders.push_back(folder);
+    }
+
+    if (m_watches.empty()) {
+        close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+
+    m_callback = std::move(callback);
+    m_debounce = debounce;
+    m_stop = false;
+    m_running = true;
+    m_thread = std::thread(&FileWatcher::Run, this);
+    return true;
+}
+
+void FileWatcher::Run() {
+    alignas(inotify_event) std::array<char, 16 * 1024> buffer;
+
+    while (!m_stop.load(std::memory_order_relaxed)) {
+        pollfd pfd{m_fd, POLLIN, 0};
+        if (poll(&pfd, 1, POLL_INTERVAL_MS) > 0 && (pfd.revents & POLLIN)) {
+            ssize_t length;
+            while ((length = read(m_fd, buffer.data(), buffer.size())) > 0) {
+                for (char* p = buffer.data(); p < buffer.data() + length;) {
+                    const auto* event = reinterpret_cast<const inotify_event*>(p);
+                    p += sizeof(inotify_event) + event->len;
+
+                    if (event->len == 0 || (event->mask & IN_ISDIR))
+                        continue;
+
+                    auto it = std::find(m_watches.begin(), m_watches.end(), event->wd);
+                    if (it == m_watches.end())
+                        continue;
+
+                    // IN_CREATE alone is followed by IN_CLOSE_WRITE once the file is written.
+                    if (event->mask == IN_CREATE)
+                        continue;
+
+                    const bool removed = event->mask & (IN_DELETE | IN_MOVED_FROM);
+                    Record(m_folders[it - m_watches.begin()] / event->name,
+                           removed ? ChangeKind::Removed : ChangeKind::Modified);
+                }
+            }
+        }
+
+        EmitQuiet();
+    }
+}
+
+void FileWatcher::Stop() {
+    m_stop = true;
+    if (m_thread.joinable())
+        m_thread.join();
+
+    if (m_fd >= 0) {
+        close(m_fd); // also removes the watches
+        m_fd = -1;
+    }
+    m_watches.clear();
+    m_folders.clear();
+    m_pending.clear();
+    m_running = false;
+}
+
+#else
+
+bool FileWatcher::Start(const std::vector<std::filesystem::path>&, Callback, std::chrono::milliseconds) {
+    return false;
+}
+
+void FileWatcher::Run() {}
+
+void FileWatcher::Stop() {
+    m_running = false;
+}
+
+#endif
@@ -0,0 +1,108 @@
+#include "JsonLogFormatter.h"
+
+#include <charconv>
+#include <cmath>
+
+namespace {
+    template <typename T>
+    void AppendNumber(std::string& out, T value) {
+        char buffer[32];
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out.append(buffer, result.ptr);
+    }
+
+    void AppendValue(std::string& out, const LogField& field) {
+        switch (field.type) {
+            case LogField::Type::Int:
+                AppendNumber(out, field.i);
+                break;
+            case LogField::Type::UInt:
+                AppendNumber(out, field.u);
+                break;
+            case LogField::Type::Double:
+                // JSON has no NaN/Infinity.
+                if (std::isfinite(field.d))
+                    AppendNumber(out, field.d);
+                else
+                    out += "null";
+                break;
+            case LogField::Type::Bool:
+                out += field.b ? "true" : "false";
+                break;
+            case LogField::Type::String:
+                JsonLogFormatter::AppendString(out, field.text);
+                break;
+        }
+    }
+}
+
+void JsonLogFormatter::AppendString(std::string& out, std::string_view text) {
+    static constexpr char hex[] = "0123456789abcdef";
+
+    out += '"';
+    size_t run = 0; // start of the current run of characters that need no escaping
+    for (size_t i = 0; i < text.size(); ++i) {
+        const unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue; // UTF-8 passes through unchanged
+
+        out.append(text.data() + run, i - run);
+        run = i + 1;
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                out += "\\u00";
+                out += hex[c >> 4];
+                out += hex[c & 0xF];
+                break;
+        }
+    }
+    out.append(text.data() + run, text.size() - run);
+    out += '"';
+}
+
+void JsonLogFormatter::Append(std::string& out, const LogRecord& record) {
+    using namespace std::chrono;
+
+    out += "{\"ts\":";
+    AppendNumber(out, static_cast<int64_t>(
+        duration_cast<microseconds>(record.time.time_since_epoch()).count()));
+    out += ",\"level\":\"";
+    out += ToString(record.level);
+    out += "\",\"thread\":";
+    AppendNumber(out, record.thread);
+    out += ",\"category\":\"";
+    out += ToString(record.category);
+    out += "\",\"msg\":";
+
+    if (record.decode) {
+        // Deferred arguments are formatted into a per-thread scratch buffer
+        // first, because the text still has to be escaped.
+        thread_local std::string scratch;
+        scratch.clear();
+        record.decode(scratch, record.format, record.args.data());
+        AppendString(out, scratch);
+    } else {
+        AppendString(out, record.message);
+    }
+
+    if (!record.fields.empty()) {
+        out += ",\"fields\":{";
+        bool first = true;
+        for (const LogField& field : record.fields) {
+            if (!first)
+                out += ',';
+            first = false;
+            AppendString(out, field.key);
+            out += ':';
+            AppendValue(out, field);
+        }
+        out += '}';
+    }
+
+    out += "}\n";
+}
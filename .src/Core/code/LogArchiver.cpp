@@ -0,0 +1,225 @@
+#include "LogArchiver.h"
+#include "Crc32.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+// The archiver is the only user of stb_image_write, so its implementation is
+// compiled here and every binary that links the logger gets the deflate
+// encoder (stbi_zlib_compress, defined by the implementation section; it
+// returns a zlib stream allocated with malloc).
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stbImage/stb_image_write.h>
+
+namespace {
+    namespace fs = std::filesystem;
+
+    void PutLE32(std::ofstream& out, uint32_t v) {
+        const char bytes[4] = {
+            static_cast<char>(v & 0xFF), static_cast<char>((v >> 8) & 0xFF),
+            static_cast<char>((v >> 16) & 0xFF), static_cast<char>((v >> 24) & 0xFF)
+        };
+        out.write(bytes, 4);
+    }
+
+    bool EndsWith(const std::string& s, std::string_view suffix) {
+        return s.size() >= suffix.size()
+            && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+}
+
+LogArchiver::LogArchiver(const std::filesystem::path& folder, const LogRotationConfig& config)
+    : m_folder(folder), m_config(config) {
+    m_thread = std::thread(&LogArchiver::Run, this);
+}
+
+LogArchiver::~LogArchiver() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+void LogArchiver::Archive(const std::filesystem::path& file) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.push_back(file);
+    }
+    m_cv.notify_one();
+}
+
+void LogArchiver::Sweep() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.emplace_back();
+    }
+    m_cv.notify_one();
+}
+
+void LogArchiver::SetActiveFile(const std::filesystem::path& file) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_active = file;
+}
+
+// The open file and files still waiting for compression are left alone.
+bool LogArchiver::IsActive(const std::filesystem::path& file) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::error_code ec;
+    if (!m_active.empty() && fs::equivalent(file, m_active, ec))
+        return true;
+    return std::find(m_pending.begin(), m_pending.end(), file) != m_pending.end();
+}
+
+bool LogArchiver::IsLogFile(const std::filesystem::path& file) {
+    const std::string name = file.filename().string();
+    return name.rfind("log_", 0) == 0 && (EndsWith(name, ".txt") || EndsWith(name, ".txt.gz"));
+}
+
+void LogArchiver::Run() {
+    while (true) {
+        fs::path job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [&] { return m_stop || !m_pending.empty(); });
+            if (m_pending.empty())
+                return; // stopping, queue drained
+
+            job = std::move(m_pending.front());
+            m_pending.pop_front();
+        }
+
+        try {
+            if (job.empty()) {
+                CompressLeftovers();
+            } else if (m_config.compress) {
+                Compress(job);
+            }
+            ApplyRetention();
+        } catch (const std::exception& e) {
+            std::cerr << "[Logger] Log archiver error: " << e.what() << std::endl;
+        }
+    }
+}
+
+void LogArchiver::Compress(const std::filesystem::path& file) {
+    if (IsActive(file))
+        return;
+
+    fs::path target = file;
+    target += ".gz";
+
+    if (!GzipFile(file, target, m_config.compressionLevel)) {
+        std::cerr << "[Logger] Failed to compress log: " << file << std::endl;
+        std::error_code ec;
+        fs::remove(target, ec);
+        return;
+    }
+
+    // Keep the original's timestamp so age-based retention still works.
+    std::error_code ec;
+    fs::last_write_time(target, fs::last_write_time(file, ec), ec);
+    fs::remove(file, ec);
+}
+
+void LogArchiver::CompressLeftovers() {
+    if (!m_config.compress || !fs::is_directory(m_folder))
+        return;
+
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::directory_iterator(m_folder)) {
+        const auto& path = entry.path();
+        if (entry.is_regular_file() && IsLogFile(path) && path.extension() == ".txt")
+            files.push_back(path);
+    }
+
+    for (const auto& file : files)
+        Compress(file);
+}
+
+void LogArchiver::ApplyRetention() {
+    if (!fs::is_directory(m_folder))
+        return;
+
+    struct Entry {
+        fs::path path;
+        fs::file_time_type time;
+        uint64_t size;
+    };
+
+    std::vector<Entry> files;
+    uint64_t total = 0;
+    for (const auto& entry : fs::directory_iterator(m_folder)) {
+        if (!entry.is_regular_file() || !IsLogFile(entry.path()) || IsActive(entry.path()))
+            continue;
+        std::error_code ec;
+        const uint64_t size = entry.file_size(ec);
+        files.push_back({entry.path(), entry.last_write_time(ec), size});
+        total += size;
+    }
+
+    std::sort(files.begin(), files.end(),
+        [](const Entry& a, const Entry& b) {
+            return a.time < b.time;
+        });
+
+    const auto now = fs::file_time_type::clock::now();
+    for (const auto& file : files) {
+        const bool tooOld = m_config.maxAge.count() > 0 && now - file.time > m_config.maxAge;
+        const bool overBudget = m_config.maxTotalBytes > 0 && total > m_config.maxTotalBytes;
+        if (!tooOld && !overBudget)
+            break; // files are sorted oldest first
+
+        std::error_code ec;
+        if (fs::remove(file.path, ec)) {
+            total -= file.size;
+            std::cout << "[Logger] Removed old log: " << file.path << std::endl;
+        }
+    }
+}
+
+bool LogArchiver::GzipFile(const std::filesystem::path& source,
+                           const std::filesystem::path& target,
+                           int level) {
+    std::ifstream in(source, std::ios::binary | std::ios::ate);
+    if (!in)
+        return false;
+
+    const std::streamoff size = in.tellg();
+    if (size < 0 || size > INT_MAX)
+        return false;
+
+    std::vector<unsigned char> data(static_cast<size_t>(size));
+    in.seekg(0);
+    if (size > 0 && !in.read(reinterpret_cast<char*>(data.data()), size))
+        return false;
+
+    int zlibSize = 0;
+    unsigned char* zlib = stbi_zlib_compress(data.data(), static_cast<int>(data.size()), &zlibSize,
+                                             std::clamp(level, 1, 9));
+    if (!zlib)
+        return false;
+
+    // zlib stream = 2-byte header + raw deflate + 4-byte Adler-32.
+    // gzip wants the raw deflate data wrapped in its own header and trailer.
+    bool ok = zlibSize >= 6;
+    if (ok) {
+        std::ofstream out(target, std::ios::binary | std::ios::trunc);
+        static constexpr unsigned char header[10] = {0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF};
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(zlib + 2), zlibSize - 6);
+        PutLE32(out, Crc32(data.data(), data.size()));
+        PutLE32(out, static_cast<uint32_t>(data.size()));
+        ok = static_cast<bool>(out);
+    }
+
+    std::free(zlib);
+    return ok;
+}
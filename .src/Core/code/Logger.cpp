@@ -1,114 +1,490 @@
 #include "Logger.h"
 
 #include <filesystem>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <utility>
 
-#include "DebugColors.h"
+#include "TimestampService.h"
+#include "LogArchiver.h"
+#include "ConsoleLogSink.h"
+#include "FileLogSink.h"
+#include "StructuredLogSink.h"
+#include "CrashRingLogSink.h"
+
+namespace {
+    // Records formatted per backend iteration before the output lock is taken.
+    constexpr size_t BACKEND_BATCH = 256;
+}
 
 Logger::Logger(LogLevel level, LogOutput output)
-    : m_logLevel(level), m_output(output) {}
+    : m_logLevel(level), m_output(output), m_consoleSink(std::make_shared<ConsoleLogSink>()) {
+    for (auto& categoryLevel : m_categoryLevels)
+        categoryLevel.store(level, std::memory_order_relaxed);
+    RebuildActiveSinks();
+}
 
 Logger::~Logger() {
-    if (m_file.is_open())
-        m_file.close();
+    DisableAsync();
+    DisableRotation();
+}
+
+void Logger::SetLogLevel(LogLevel level) {
+    std::lock_guard<std::mutex> lock(m_levelMutex);
+    m_logLevel = level;
+    for (size_t i = 0; i < LOG_CATEGORY_COUNT; ++i) {
+        if (!m_categoryOverridden[i])
+            m_categoryLevels[i].store(level, std::memory_order_relaxed);
+    }
+}
+
+void Logger::SetCategoryLevel(LogCategory category, LogLevel level) {
+    std::lock_guard<std::mutex> lock(m_levelMutex);
+    const size_t i = static_cast<size_t>(category);
+    m_categoryOverridden[i] = true;
+    m_categoryLevels[i].store(level, std::memory_order_relaxed);
+}
+
+void Logger::ResetCategoryLevel(LogCategory category) {
+    std::lock_guard<std::mutex> lock(m_levelMutex);
+    const size_t i = static_cast<size_t>(category);
+    m_categoryOverridden[i] = false;
+    m_categoryLevels[i].store(m_logLevel, std::memory_order_relaxed);
 }
 
 void Logger::SetLogFile(const std::string& folderPath) {
+    std::unique_ptr<LogArchiver> archiver;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Rotation belonged to the previous folder; call EnableRotation() again.
+        // The old archiver is joined after the lock is released.
+        if (m_fileSink)
+            archiver = m_fileSink->DetachArchiver();
+
+        auto sink = std::make_shared<FileLogSink>(m_fileSink ? m_fileSink->GetLevel() : LogLevel::Trace);
+        if (sink->Open(folderPath))
+            std::cout << "[Logger] Logging to file: " << sink->GetPath() << std::endl;
+
+        m_fileSink = std::move(sink);
+        RebuildActiveSinks();
+    }
+}
+
+std::string Logger::GetLogFile() const {
+    // Rotation renames the file on the writing thread, under m_mutex.
     std::lock_guard<std::mutex> lock(m_mutex);
+    return m_fileSink ? m_fileSink->GetPath() : std::string{};
+}
+
+void Logger::SetOutput(LogOutput output) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_output = output;
+    RebuildActiveSinks();
+}
+
+void Logger::EnableRotation(const LogRotationConfig& config) {
+    std::unique_ptr<LogArchiver> previous;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_fileSink) {
+            std::cerr << "[Logger] EnableRotation: call SetLogFile first" << std::endl;
+            return;
+        }
+
+        previous = m_fileSink->DetachArchiver();
+        m_fileSink->EnableRotation(config);
+    }
+    // Joined outside the lock: it may still be compressing.
+    previous.reset();
+}
+
+void Logger::DisableRotation() {
+    std::unique_ptr<LogArchiver> previous;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_fileSink)
+            previous = m_fileSink->DetachArchiver();
+    }
+    previous.reset();
+}
+
+void Logger::AddSink(std::shared_ptr<ILogSink> sink) {
+    if (!sink)
+        return;
+
+    std::shared_ptr<ILogSink> replaced;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& existing : m_extraSinks) {
+            if (existing->GetName() == sink->GetName()) {
+                existing->Commit();
+                existing->Flush();
+                replaced = std::exchange(existing, std::move(sink));
+                break;
+            }
+        }
+        if (sink)
+            m_extraSinks.push_back(std::move(sink));
+        RebuildActiveSinks();
+    }
+}
 
-    using namespace std::chrono;
-    auto now = system_clock::now();
-    auto time = system_clock::to_time_t(now);
+void Logger::RemoveSink(std::string_view name) {
+    std::shared_ptr<ILogSink> removed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = std::find_if(m_extraSinks.begin(), m_extraSinks.end(),
+            [&](const auto& sink) { return sink->GetName() == name; });
+        if (it == m_extraSinks.end())
+            return;
 
-    std::tm tm {};
-#ifdef _WIN32
-    localtime_s(&tm, &time);
-#else
-    localtime_r(&time, &tm);
-#endif
+        (*it)->Commit();
+        (*it)->Flush();
+        removed = std::move(*it);
+        m_extraSinks.erase(it);
+        RebuildActiveSinks();
+    }
+}
 
-    // Формируем имя файла: log_YYYY-MM-DD_HH-MM-SS.txt
-    std::ostringstream name;
-    name << "log_"
-         << std::put_time(&tm, "%Y-%m-%d_%H-%M-%S")
-         << ".txt";
+std::shared_ptr<ILogSink> Logger::FindSink(std::string_view name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (name == m_consoleSink->GetName())
+        return m_consoleSink;
+    if (m_fileSink && name == m_fileSink->GetName())
+        return m_fileSink;
+    for (const auto& sink : m_extraSinks) {
+        if (sink->GetName() == name)
+            return sink;
+    }
+    return nullptr;
+}
 
-    // Полный путь: folderPath + имя файла
-    m_filePath = folderPath;
-    if (!m_filePath.empty() && (m_filePath.back() != '/' && m_filePath.back() != '\\'))
-        m_filePath += "\\";
+// Caller holds m_mutex.
+void Logger::RebuildActiveSinks() {
+    m_activeSinks.clear();
+    if (m_output == LogOutput::Console || m_output == LogOutput::Both)
+        m_activeSinks.push_back(m_consoleSink.get());
+    if ((m_output == LogOutput::File || m_output == LogOutput::Both) && m_fileSink && m_fileSink->IsOpen())
+        m_activeSinks.push_back(m_fileSink.get());
+    for (const auto& sink : m_extraSinks)
+        m_activeSinks.push_back(sink.get());
+}
 
-    m_filePath += name.str();
+// Hands a record to every sink whose level lets it through. Deferred
+// arguments are formatted once, and only if at least one sink wants the
+// record. Caller holds m_mutex.
+size_t Logger::Dispatch(LogRecord& record) {
+    size_t accepted = 0;
+    for (ILogSink* sink : m_activeSinks) {
+        if (record.level < sink->GetLevel())
+            continue;
+        if (accepted++ == 0)
+            record.Resolve();
+        sink->Write(record);
+    }
+    return accepted;
+}
 
-    if (m_file.is_open())
-        m_file.close();
+// Caller holds m_mutex.
+void Logger::CommitSinks() {
+    for (ILogSink* sink : m_activeSinks)
+        sink->Commit();
+}
 
-    m_file.open(m_filePath, std::ios::app);
-    if (!m_file)
-        std::cerr << "[Logger] Failed to open log file: " << m_filePath << std::endl;
-    else
-        std::cout << "[Logger] Logging to file: " << m_filePath << std::endl;
+// Caller holds m_mutex.
+void Logger::FlushSinks() {
+    for (ILogSink* sink : m_activeSinks)
+        sink->Flush();
 }
 
 void Logger::Log(LogLevel level, std::string_view message) {
     if (level < m_logLevel)
         return;
 
+    LogRecord record;
+    record.level = level;
+    record.thread = CurrentLogThreadId();
+    record.time = TimestampService::Now();
+    record.message.assign(message);
+    Submit(std::move(record));
+}
+
+void Logger::Submit(LogRecord&& record) {
+    // Announce the producer before checking the mode: EnableAsync() clears
+    // m_async and then waits for m_producers to drain before it touches the
+    // queue or the config (seq_cst on both sides).
+    m_producers.fetch_add(1, std::memory_order_seq_cst);
+    if (m_async.load(std::memory_order_seq_cst)) {
+        const bool queued = Enqueue(record);
+        m_producers.fetch_sub(1, std::memory_order_release);
+        if (queued)
+            return;
+    } else {
+        m_producers.fetch_sub(1, std::memory_order_release);
+    }
+
+    // Synchronous mode keeps the old line-by-line behaviour: every record
+    // reaches its devices before the call returns.
     std::lock_guard<std::mutex> lock(m_mutex);
+    WriteStragglers();
+    Dispatch(record);
+    CommitSinks();
+    FlushSinks();
+}
+
+// Records pushed by threads that raced with DisableAsync() go out first.
+// Caller holds m_mutex.
+void Logger::WriteStragglers() {
+    if (!m_queue || m_queue->EmptyApprox())
+        return;
+
+    LogRecord straggler;
+    while (m_queue->TryPop(straggler))
+        Dispatch(straggler);
+    CommitSinks();
+}
 
-    std::string timestamp = GetTimeStamp();
-    std::string levelStr = LevelToString(level);
-    const char* color = LevelColor(level);
+void Logger::SetStructuredLogFile(const std::string& filePath) {
+    auto sink = std::make_shared<StructuredLogSink>(filePath);
+    if (sink->IsOpen())
+        AddSink(std::move(sink));
+}
+
+void Logger::DisableStructuredLog() {
+    RemoveSink("structured");
+}
+
+bool Logger::EnableCrashRing(const std::string& filePath, size_t capacity) {
+    auto sink = std::make_shared<CrashRingLogSink>();
+    if (!sink->Open(filePath, capacity)) {
+        std::cerr << "[Logger] Failed to map crash log ring: " << filePath << std::endl;
+        return false;
+    }
+    AddSink(std::move(sink));
+    return true;
+}
+
+void Logger::DisableCrashRing() {
+    RemoveSink("crash_ring");
+}
+
+void Logger::Flush() {
+    LogSiteDedup::TakePending(*this, true, [this](LogCategory category, LogLevel level, uint32_t repeats) {
+        LogF(category, level, LOG_DEDUP_REPEATED_FORMAT, repeats);
+    });
+
+    if (!m_async.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        FlushSinks();
+        return;
+    }
+
+    const uint64_t target = m_enqueued.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(m_backendMutex);
+    m_flushRequested = true;
+    m_backendCv.notify_one();
+    m_drainedCv.wait(lock, [&] {
+        return m_flushed.load(std::memory_order_acquire) >= target || !m_async.load(std::memory_order_acquire);
+    });
+}
 
-    std::string formatted = "[" + timestamp + "] [" + levelStr + "] " + std::string(message);
+void Logger::EnableAsync(const AsyncLogConfig& config) {
+    std::lock_guard<std::mutex> control(m_asyncControlMutex);
 
-    // Console output
-    if (m_output == LogOutput::Console || m_output == LogOutput::Both) {
-        std::cout << color << formatted << DebugColors::Reset << std::endl;
+    if (m_backend.joinable()) {
+        // Restart with the new configuration.
+        m_async.store(false, std::memory_order_seq_cst);
+        m_backendStop.store(true, std::memory_order_release);
+        m_backendCv.notify_one();
+        m_backend.join();
     }
 
-    // File output
-    if ((m_output == LogOutput::File || m_output == LogOutput::Both) && m_file.is_open()) {
-        m_file << formatted << std::endl;
+    // New callers now log synchronously; wait for those still inside Enqueue()
+    // before the queue or the overflow policy they read can change.
+    m_spaceCv.notify_all();
+    while (m_producers.load(std::memory_order_seq_cst) != 0)
+        std::this_thread::yield();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_asyncConfig = config;
+        if (!m_queue || m_queue->Capacity() < config.queueCapacity) {
+            // Write out anything left in the old queue before replacing it.
+            WriteStragglers();
+            m_queue = std::make_unique<MpscRingBuffer<LogRecord>>(config.queueCapacity);
+        }
+    }
+
+    m_enqueued.store(0, std::memory_order_relaxed);
+    m_written.store(0, std::memory_order_relaxed);
+    m_flushed.store(0, std::memory_order_relaxed);
+    m_backendStop.store(false, std::memory_order_release);
+    m_backend = std::thread(&Logger::BackendLoop, this);
+    m_async.store(true, std::memory_order_release);
+}
+
+void Logger::DisableAsync() {
+    std::lock_guard<std::mutex> control(m_asyncControlMutex);
+    if (!m_backend.joinable())
+        return;
+
+    m_async.store(false, std::memory_order_release);
+    m_backendStop.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(m_backendMutex);
+        m_backendCv.notify_one();
     }
+    m_backend.join();
+    m_drainedCv.notify_all();
+    m_spaceCv.notify_all();
 }
 
-std::string Logger::GetTimeStamp() const {
-    using namespace std::chrono;
-    auto now = system_clock::now();
-    auto time = system_clock::to_time_t(now);
+// Returns false if the backend went away while waiting for room; the caller
+// then writes @p record synchronously. Caller is counted in m_producers.
+bool Logger::Enqueue(LogRecord& record) {
+    const bool urgent = record.level >= LogLevel::Error;
+
+    switch (m_asyncConfig.overflow) {
+        case LogOverflowPolicy::DropNewest:
+            if (!m_queue->TryPush(std::move(record))) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            break;
+
+        case LogOverflowPolicy::DropOldest:
+            while (!m_queue->TryPush(std::move(record))) {
+                LogRecord evicted;
+                if (m_queue->TryPop(evicted)) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    m_written.fetch_add(1, std::memory_order_relaxed); // never will be, but counts as done
+                }
+            }
+            break;
+
+        case LogOverflowPolicy::Block:
+            while (!m_queue->TryPush(std::move(record))) {
+                std::unique_lock<std::mutex> lock(m_backendMutex);
+                m_backendCv.notify_one();
+                m_spaceCv.wait_for(lock, std::chrono::milliseconds(1));
+                if (!m_async.load(std::memory_order_acquire))
+                    return false; // backend gone: the caller writes synchronously
+            }
+            break;
+    }
 
-    std::tm tm {};
-#ifdef _WIN32
-    localtime_s(&tm, &time);
-#else
-    localtime_r(&time, &tm);
-#endif
-    std::ostringstream ss;
-    ss << std::put_time(&tm, "%H:%M:%S");
-    return ss.str();
+    m_enqueued.fetch_add(1, std::memory_order_release);
+
+    if (urgent || m_queue->SizeApprox() >= m_asyncConfig.flushBatchSize)
+        m_backendCv.notify_one();
+    return true;
 }
 
-std::string Logger::LevelToString(LogLevel level) const {
-    switch (level) {
-        case LogLevel::Trace:    return "TRACE";
-        case LogLevel::Debug:    return "DEBUG";
-        case LogLevel::Info:     return "INFO";
-        case LogLevel::Warning:  return "WARN";
-        case LogLevel::Error:    return "ERROR";
-        case LogLevel::Critical: return "CRIT";
-        default:                 return "UNKNOWN";
+// Formats and writes up to BACKEND_BATCH records. Callers never take
+// m_mutex in async mode, so holding it here only excludes configuration changes.
+size_t Logger::WriteBatch(bool& urgent) {
+    if (m_queue->EmptyApprox())
+        return 0;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t count = 0;
+    LogRecord rec;
+    while (count < BACKEND_BATCH && m_queue->TryPop(rec)) {
+        if (Dispatch(rec) > 0 && rec.level >= LogLevel::Error)
+            urgent = true;
+        ++count;
     }
+
+    if (count > 0)
+        CommitSinks();
+    return count;
 }
 
-const char* Logger::LevelColor(LogLevel level) const {
-    switch (level) {
-        case LogLevel::Trace:    return DebugColors::White;     // white
-        case LogLevel::Debug:    return DebugColors::Cyan;      // cyan
-        case LogLevel::Info:     return DebugColors::Green;     // green
-        case LogLevel::Warning:  return DebugColors::Yellow;    // yellow
-        case LogLevel::Error:    return DebugColors::Red;       // red
-        case LogLevel::Critical: return DebugColors::BrightRed; // bright red
-        default:                 return DebugColors::White;
+// Reports LOG_DEDUPED sites whose window ended with copies still dropped.
+// Written directly: the backend must never wait for room in its own queue.
+size_t Logger::WriteDedupRepeats() {
+    size_t written = 0;
+    LogSiteDedup::TakePending(*this, false, [this, &written](LogCategory category, LogLevel level, uint32_t repeats) {
+        if (!ShouldLog(category, level))
+            return;
+
+        LogRecord record;
+        record.level = level;
+        record.category = category;
+        record.thread = CurrentLogThreadId();
+        record.time = TimestampService::Now();
+        record.SetDeferred(LOG_DEDUP_REPEATED_FORMAT, repeats);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (Dispatch(record) > 0) {
+            CommitSinks();
+            ++written;
+        }
+    });
+    return written;
+}
+
+void Logger::BackendLoop() {
+    using clock = std::chrono::steady_clock;
+
+    auto lastFlush = clock::now();
+    size_t sinceFlush = 0;
+
+    while (true) {
+        const bool stopping = m_backendStop.load(std::memory_order_acquire);
+
+        bool urgent = false;
+        const size_t n = WriteBatch(urgent);
+        if (n > 0) {
+            sinceFlush += n;
+            m_written.fetch_add(n, std::memory_order_release);
+            m_spaceCv.notify_all();
+        }
+
+        bool flushRequested;
+        {
+            std::lock_guard<std::mutex> lock(m_backendMutex);
+            flushRequested = m_flushRequested;
+            m_flushRequested = false;
+        }
+
+        const auto now = clock::now();
+        const bool flushNow = flushRequested
+            || (urgent && m_asyncConfig.flushOnError)
+            || sinceFlush >= m_asyncConfig.flushBatchSize
+            || (sinceFlush > 0 && now - lastFlush >= m_asyncConfig.flushInterval)
+            || (stopping && n == 0);
+
+        if (flushNow) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                FlushSinks();
+            }
+            sinceFlush = 0;
+            lastFlush = now;
+
+            std::lock_guard<std::mutex> lock(m_backendMutex);
+            m_flushed.store(m_written.load(std::memory_order_acquire), std::memory_order_release);
+            m_drainedCv.notify_all();
+        }
+
+        if (n > 0)
+            continue;
+
+        if (stopping)
+            break;
+
+        sinceFlush += WriteDedupRepeats(); // flushed with the next interval
+
+        std::unique_lock<std::mutex> lock(m_backendMutex);
+        m_backendCv.wait_for(lock, m_asyncConfig.flushInterval, [&] {
+            return m_backendStop.load(std::memory_order_acquire)
+                || m_flushRequested
+                || !m_queue->EmptyApprox();
+        });
     }
 }
 
@@ -0,0 +1,167 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+#ifdef _WIN32
+        std::swap(m_file, other.m_file);
+        std::swap(m_mapping, other.m_mapping);
+#else
+        std::swap(m_fd, other.m_fd);
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::filesystem::path& path, Access access, size_t size) {
+    Close();
+
+    const bool writable = access == Access::ReadWrite;
+    HANDLE file = CreateFileW(path.c_str(),
+                              GENERIC_READ | (writable ? GENERIC_WRITE : 0),
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr,
+                              writable ? OPEN_ALWAYS : OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER length {};
+    if (writable && size > 0) {
+        length.QuadPart = static_cast<LONGLONG>(size);
+        if (!SetFilePointerEx(file, length, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+            CloseHandle(file);
+            return false;
+        }
+    } else if (!GetFileSizeEx(file, &length)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    if (length.QuadPart == 0) {
+        CloseHandle(file);
+        return false; // empty files cannot be mapped
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_data = view;
+    m_size = static_cast<size_t>(length.QuadPart);
+    return true;
+}
+
+void MappedFile::Close() noexcept {
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mapping)
+        CloseHandle(m_mapping);
+    if (m_file)
+        CloseHandle(m_file);
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = nullptr;
+    m_size = 0;
+}
+
+void MappedFile::Flush(bool wait) noexcept {
+    if (!m_data)
+        return;
+    FlushViewOfFile(m_data, 0);
+    if (wait)
+        FlushFileBuffers(m_file);
+}
+
+#else
+
+bool MappedFile::Open(const std::filesystem::path& path, Access access, size_t size) {
+    Close();
+
+    const bool writable = access == Access::ReadWrite;
+    const int fd = ::open(path.c_str(), writable ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+    if (fd < 0)
+        return false;
+
+    if (writable && size > 0) {
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            ::close(fd);
+            return false;
+        }
+    } else {
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        size = static_cast<size_t>(st.st_size);
+    }
+
+    if (size == 0) {
+        ::close(fd);
+        return false; // empty files cannot be mapped
+    }
+
+    void* view = ::mmap(nullptr, size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_data = view;
+    m_size = size;
+    return true;
+}
+
+void MappedFile::Close() noexcept {
+    if (m_data)
+        ::munmap(m_data, m_size);
+    if (m_fd >= 0)
+        ::close(m_fd);
+    m_data = nullptr;
+    m_fd = -1;
+    m_size = 0;
+}
+
+void MappedFile::Flush(bool wait) noexcept {
+    if (m_data)
+        ::msync(m_data, m_size, wait ? MS_SYNC : MS_ASYNC);
+}
+
+#endif
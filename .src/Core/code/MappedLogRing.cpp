@@ -0,0 +1,128 @@
+#include "MappedLogRing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include "Crc32.h"
+
+bool MappedLogRing::Open(const std::filesystem::path& path, size_t capacity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    capacity = std::max<size_t>(capacity, 4096);
+    if (!m_map.Open(path, MappedFile::Access::ReadWrite, sizeof(Header) + capacity))
+        return false;
+
+    Header* header = HeaderPtr();
+    const bool continues = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0
+        && header->version == VERSION
+        && header->headerSize == sizeof(Header)
+        && header->capacity == capacity;
+
+    if (!continues) {
+        std::memset(header, 0, sizeof(Header));
+        header->version = VERSION;
+        header->headerSize = sizeof(Header);
+        header->capacity = capacity;
+        header->writePos = 0;
+        std::memcpy(header->magic, MAGIC, sizeof(MAGIC));
+    }
+
+    m_capacity = capacity;
+    return true;
+}
+
+void MappedLogRing::Close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_map.Close();
+    m_capacity = 0;
+}
+
+void MappedLogRing::Append(LogLevel level, std::string_view text) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_map.IsOpen())
+        return;
+
+    if (text.size() > m_capacity / 2)
+        text = text.substr(0, m_capacity / 2);
+
+    Frame frame {};
+    frame.marker = FRAME_MARKER;
+    frame.size = static_cast<uint32_t>(text.size());
+    frame.crc = Crc32(text.data(), text.size());
+    frame.level = static_cast<uint8_t>(level);
+
+    std::atomic_ref<uint64_t> writePos(HeaderPtr()->writePos);
+    const uint64_t pos = writePos.load(std::memory_order_relaxed);
+
+    Write(pos, &frame, sizeof(frame));
+    Write(pos + sizeof(frame), text.data(), text.size());
+
+    // A reader (or the post-mortem tool) never sees a half-written frame.
+    writePos.store(pos + sizeof(frame) + text.size(), std::memory_order_release);
+}
+
+void MappedLogRing::Write(uint64_t pos, const void* src, size_t size) {
+    const size_t offset = static_cast<size_t>(pos % m_capacity);
+    const size_t first = std::min(size, static_cast<size_t>(m_capacity) - offset);
+    std::memcpy(Ring() + offset, src, first);
+    if (first < size)
+        std::memcpy(Ring(), static_cast<const std::byte*>(src) + first, size - first);
+}
+
+void MappedLogRing::ReadAt(const std::byte* ring, uint64_t capacity, uint64_t pos, void* dst, size_t size) {
+    const size_t offset = static_cast<size_t>(pos % capacity);
+    const size_t first = std::min(size, static_cast<size_t>(capacity) - offset);
+    std::memcpy(dst, ring + offset, first);
+    if (first < size)
+        std::memcpy(static_cast<std::byte*>(dst) + first, ring, size - first);
+}
+
+std::vector<MappedLogRing::Entry> MappedLogRing::Read(const std::byte* data, size_t size) {
+    std::vector<Entry> entries;
+    if (size < sizeof(Header))
+        return entries;
+
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+        || header.version != VERSION
+        || header.capacity == 0
+        || sizeof(Header) + header.capacity > size)
+        return entries;
+
+    const std::byte* ring = data + sizeof(Header);
+    const uint64_t capacity = header.capacity;
+    const uint64_t end = header.writePos;
+
+    // The oldest bytes were overwritten: the first whole frame has to be
+    // found by scanning for a marker whose checksum matches.
+    uint64_t pos = end > capacity ? end - capacity : 0;
+    std::string text;
+    while (pos + sizeof(Frame) <= end) {
+        Frame frame;
+        ReadAt(ring, capacity, pos, &frame, sizeof(frame));
+
+        const bool plausible = frame.marker == FRAME_MARKER
+            && frame.size <= capacity
+            && pos + sizeof(Frame) + frame.size <= end;
+        if (plausible) {
+            text.resize(frame.size);
+            ReadAt(ring, capacity, pos + sizeof(Frame), text.data(), frame.size);
+            if (Crc32(text.data(), text.size()) == frame.crc) {
+                entries.push_back({static_cast<LogLevel>(frame.level), text});
+                pos += sizeof(Frame) + frame.size;
+                continue;
+            }
+        }
+        ++pos; // resynchronise
+    }
+    return entries;
+}
+
+std::vector<MappedLogRing::Entry> MappedLogRing::ReadFile(const std::filesystem::path& path) {
+    MappedFile map;
+    if (!map.Open(path, MappedFile::Access::ReadOnly))
+        return {};
+    return Read(map.Data(), map.Size());
+}
@@ -0,0 +1,136 @@
+#include "Symbol.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    // id → text lives in fixed-size chunks that are never moved, so View()
+    // can read it without the lock.
+    constexpr uint32_t CHUNK_BITS = 12;
+    constexpr uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;
+    constexpr uint32_t MAX_CHUNKS = 1u << 12; // 16M symbols
+
+    // Texts are copied into arena blocks of this size (longer ones get their own).
+    constexpr size_t ARENA_BLOCK_SIZE = 64 * 1024;
+
+    class SymbolTable {
+    public:
+        // Never destroyed: symbols may still be read from other statics' destructors.
+        static SymbolTable& Instance() {
+            static SymbolTable* table = new SymbolTable();
+            return *table;
+        }
+
+        uint32_t Intern(std::string_view text) {
+            if (text.empty())
+                return 0;
+
+            {
+                std::shared_lock lock(m_mutex);
+                if (auto it = m_ids.find(text); it != m_ids.end())
+                    return it->second;
+            }
+
+            std::unique_lock lock(m_mutex);
+            if (auto it = m_ids.find(text); it != m_ids.end())
+                return it->second; // interned by another thread meanwhile
+
+            const uint32_t id = m_count.load(std::memory_order_relaxed);
+            if (id >= CHUNK_SIZE * MAX_CHUNKS)
+                throw std::length_error("Symbol table is full");
+
+            std::atomic<std::string_view*>& chunk = m_chunks[id >> CHUNK_BITS];
+            std::string_view* views = chunk.load(std::memory_order_relaxed);
+            if (!views) {
+                views = new std::string_view[CHUNK_SIZE];
+                chunk.store(views, std::memory_order_release);
+            }
+
+            const std::string_view stored = Store(text);
+            views[id & (CHUNK_SIZE - 1)] = stored;
+            m_ids.emplace(stored, id);
+            m_count.store(id + 1, std::memory_order_release);
+            return id;
+        }
+
+        std::optional<uint32_t> Find(std::string_view text) const {
+            if (text.empty())
+                return 0;
+
+            std::shared_lock lock(m_mutex);
+            if (auto it = m_ids.find(text); it != m_ids.end())
+                return it->second;
+            return std::nullopt;
+        }
+
+        std::string_view View(uint32_t id) const noexcept {
+            // A symbol only reaches another thread after Intern() returned it,
+            // which happens after its slot was written.
+            const std::string_view* views = m_chunks[id >> CHUNK_BITS].load(std::memory_order_acquire);
+            return views[id & (CHUNK_SIZE - 1)];
+        }
+
+        size_t Count() const noexcept {
+            return m_count.load(std::memory_order_acquire);
+        }
+
+    private:
+        SymbolTable() {
+            // Slot 0 is the empty string.
+            m_chunks[0].store(new std::string_view[CHUNK_SIZE], std::memory_order_relaxed);
+        }
+
+        std::string_view Store(std::string_view text) {
+            if (text.size() > m_arenaLeft) {
+                const size_t size = std::max(ARENA_BLOCK_SIZE, text.size());
+                m_arena.push_back(std::make_unique<char[]>(size));
+                m_arenaCursor = m_arena.back().get();
+                m_arenaLeft = size;
+            }
+
+            char* stored = m_arenaCursor;
+            std::copy(text.begin(), text.end(), stored);
+            m_arenaCursor += text.size();
+            m_arenaLeft -= text.size();
+            return {stored, text.size()};
+        }
+
+        mutable std::shared_mutex m_mutex;
+        std::unordered_map<std::string_view, uint32_t> m_ids; // views into m_arena
+        std::atomic<uint32_t> m_count{1};
+        std::atomic<std::string_view*> m_chunks[MAX_CHUNKS] {};
+
+        std::vector<std::unique_ptr<char[]>> m_arena;
+        char* m_arenaCursor = nullptr;
+        size_t m_arenaLeft = 0;
+    };
+}
+
+Symbol::Symbol(std::string_view text)
+    : m_id(SymbolTable::Instance().Intern(text)) {
+}
+
+std::optional<Symbol> Symbol::Find(std::string_view text) {
+    const std::optional<uint32_t> id = SymbolTable::Instance().Find(text);
+    if (!id)
+        return std::nullopt;
+
+    Symbol symbol;
+    symbol.m_id = *id;
+    return symbol;
+}
+
+size_t Symbol::Count() noexcept {
+    return SymbolTable::Instance().Count();
+}
+
+std::string_view Symbol::View() const noexcept {
+    return SymbolTable::Instance().View(m_id);
+}
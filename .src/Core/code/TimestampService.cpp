@@ -0,0 +1,105 @@
+#include "TimestampService.h"
+
+#include <cstring>
+#include <ctime>
+
+namespace {
+    // Formatted local date/time of one wall-clock second.
+    struct SecondCache {
+        int64_t second = INT64_MIN;
+        char text[19] {}; // "YYYY-MM-DD HH:MM:SS"
+    };
+
+    thread_local SecondCache t_cache;
+
+    void Put2(char* out, int value) {
+        out[0] = static_cast<char>('0' + value / 10);
+        out[1] = static_cast<char>('0' + value % 10);
+    }
+
+    void Put4(char* out, int value) {
+        Put2(out, value / 100);
+        Put2(out + 2, value % 100);
+    }
+
+    void PutMicros(char* out, uint32_t micros) {
+        for (int i = 5; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + micros % 10);
+            micros /= 10;
+        }
+    }
+
+    // Splits a time point into whole seconds and microseconds and refreshes
+    // the calling thread's cache when the second changed.
+    const SecondCache& Resolve(TimestampService::Clock::time_point time, uint32_t& micros) {
+        using namespace std::chrono;
+
+        const auto us = duration_cast<microseconds>(time.time_since_epoch()).count();
+        int64_t second = us / 1'000'000;
+        int64_t rest = us % 1'000'000;
+        if (rest < 0) {
+            rest += 1'000'000;
+            --second;
+        }
+        micros = static_cast<uint32_t>(rest);
+
+        SecondCache& cache = t_cache;
+        if (cache.second != second) {
+            const std::time_t t = static_cast<std::time_t>(second);
+            std::tm tm {};
+#ifdef _WIN32
+            localtime_s(&tm, &t);
+#else
+            localtime_r(&t, &tm);
+#endif
+            char* p = cache.text;
+            Put4(p, tm.tm_year + 1900);
+            p[4] = '-';
+            Put2(p + 5, tm.tm_mon + 1);
+            p[7] = '-';
+            Put2(p + 8, tm.tm_mday);
+            p[10] = ' ';
+            Put2(p + 11, tm.tm_hour);
+            p[13] = ':';
+            Put2(p + 14, tm.tm_min);
+            p[16] = ':';
+            Put2(p + 17, tm.tm_sec);
+            cache.second = second;
+        }
+        return cache;
+    }
+}
+
+void TimestampService::FormatTime(Clock::time_point time, char* out) noexcept {
+    uint32_t micros = 0;
+    const SecondCache& cache = Resolve(time, micros);
+    std::memcpy(out, cache.text + 11, 8);
+    out[8] = '.';
+    PutMicros(out + 9, micros);
+}
+
+void TimestampService::FormatDateTime(Clock::time_point time, char* out) noexcept {
+    uint32_t micros = 0;
+    const SecondCache& cache = Resolve(time, micros);
+    std::memcpy(out, cache.text, 19);
+    out[19] = '.';
+    PutMicros(out + 20, micros);
+}
+
+void TimestampService::AppendTime(std::string& out, Clock::time_point time) {
+    char buffer[TIME_LENGTH];
+    FormatTime(time, buffer);
+    out.append(buffer, TIME_LENGTH);
+}
+
+void TimestampService::AppendDateTime(std::string& out, Clock::time_point time) {
+    char buffer[DATE_TIME_LENGTH];
+    FormatDateTime(time, buffer);
+    out.append(buffer, DATE_TIME_LENGTH);
+}
+
+std::string TimestampService::TimeString(Clock::time_point time) {
+    std::string out;
+    AppendTime(out, time);
+    return out;
+}
@@ -7,6 +7,7 @@
 
 #include "IStaticBlock.h"
 #include "ILogger.h"
+#include "LogMacros.h"
 
 /**
  * @brief Custom hash function for @ref BlockType enumeration.
@@ -188,12 +189,10 @@ public:
     {
         if (logger)
         {
-            logger->Info(
-                "[BlockFactory] 📦 Registered blocks: " +
-                std::to_string(GetStaticCount()) +
-                " static, " +
-                std::to_string(GetDynamicCount()) +
-                " dynamic");
+            LOG_INFO(*logger, LogCategory::Blocks,
+                     "[BlockFactory] 📦 Registered blocks: {} static, {} dynamic",
+                     GetStaticCount(),
+                     GetDynamicCount());
         }
     }
 };
\ No newline at end of file
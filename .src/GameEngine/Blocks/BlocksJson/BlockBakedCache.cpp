@@ -0,0 +1,676 @@
+#include "BlockBakedCache.h"
+#include "MappedFile.h"
+#include "Crc32.h"
+#include "LogMacros.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    constexpr char BAKE_MAGIC[8] = {'M', 'X', 'B', 'L', 'K', 'B', 'A', 'K'};
+
+    // Sections of the blob, in file order.
+    enum Section : uint32_t
+    {
+        StringIndex, ///< BakedString[]
+        StringData,  ///< char[]
+        Sources,     ///< BakedSource[]
+        Blocks,      ///< BakedBlock[]
+        KeyValues,   ///< BakedKeyValue[] (state properties, variants, textures)
+        Models,      ///< BakedModel[]
+        Elements,    ///< BakedElement[]
+        Faces,       ///< BakedFace[]
+        Blobs,       ///< std::byte[] (CBOR of vanilla "elements")
+        SectionCount
+    };
+
+    struct SectionRef
+    {
+        uint64_t offset; ///< From the start of the file, 8-byte aligned.
+        uint64_t count;  ///< Number of records (bytes for StringData/Blobs).
+    };
+
+    struct BakeHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t headerSize;
+        uint32_t sectionCount;
+        uint32_t payloadCrc; ///< CRC-32 of everything after the header.
+        uint64_t fileSize;
+        SectionRef sections[SectionCount];
+    };
+
+    struct BakedString
+    {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct BakedSource
+    {
+        uint32_t folder;
+        uint32_t name;
+        uint64_t size;
+        int64_t mtime;
+        uint32_t crc;
+        uint32_t reserved;
+    };
+
+    struct BakedKeyValue
+    {
+        uint32_t key;
+        uint32_t value;
+    };
+
+    struct BakedBlock
+    {
+        uint32_t name;
+        uint32_t propertyFirst, propertyCount;
+        uint32_t variantFirst, variantCount;
+        uint32_t modelFirst, modelCount;
+        uint8_t stateLoaded, definitionLoaded;
+        uint8_t isTransparent, isSolid, isOpaque, isFullCube;
+        uint8_t reserved[2];
+    };
+
+    struct BakedModel
+    {
+        uint32_t name;
+        uint8_t wasLoaded, isBlockbench, hasRawElements, reserved;
+        uint32_t formatVersion, credit, parent;
+        uint32_t textureFirst, textureCount;
+        uint32_t elementFirst, elementCount;
+        uint32_t blobOffset, blobSize;
+    };
+
+    struct BakedElement
+    {
+        float from[3];
+        float to[3];
+        float angle;
+        uint32_t axis;
+        float origin[3];
+        uint32_t faceFirst, faceCount;
+    };
+
+    struct BakedFace
+    {
+        uint32_t name;
+        float uv[4];
+        uint32_t texture;
+        uint32_t cullface;
+    };
+
+    static_assert(std::is_trivially_copyable_v<BakeHeader> && std::is_trivially_copyable_v<BakedModel> &&
+                  std::is_trivially_copyable_v<BakedElement> && std::is_trivially_copyable_v<BakedFace>);
+
+    constexpr uint64_t Align8(uint64_t v) { return (v + 7) & ~uint64_t{7}; }
+
+    int64_t ToTicks(fs::file_time_type time)
+    {
+        return static_cast<int64_t>(time.time_since_epoch().count());
+    }
+
+    bool HashFile(const fs::path &path, uint32_t &crc)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+
+        std::array<char, 64 * 1024> buffer;
+        crc = 0;
+        while (file)
+        {
+            file.read(buffer.data(), buffer.size());
+            crc = Crc32(buffer.data(), static_cast<size_t>(file.gcount()), crc);
+        }
+        return true;
+    }
+
+    std::string_view KeyText(const std::string &key) { return key; }
+    std::string_view KeyText(Symbol key) { return key.View(); }
+
+    // Sorted by text, not by symbol id: ids depend on interning order.
+    template <typename Map>
+    std::vector<typename Map::const_pointer> SortedByKey(const Map &map)
+    {
+        std::vector<typename Map::const_pointer> items;
+        items.reserve(map.size());
+        for (const auto &item : map)
+            items.push_back(&item);
+        std::sort(items.begin(), items.end(), [](auto a, auto b) { return KeyText(a->first) < KeyText(b->first); });
+        return items;
+    }
+
+    /**
+     * @brief Builds the blob in memory.
+     *
+     * Maps are written in key order so that the same data always bakes to
+     * the same bytes.
+     */
+    class BakeWriter
+    {
+    public:
+        uint32_t Intern(std::string_view text)
+        {
+            if (auto it = ids_.find(std::string(text)); it != ids_.end())
+                return it->second;
+
+            const auto id = static_cast<uint32_t>(strings_.size());
+            strings_.push_back({static_cast<uint32_t>(stringData_.size()), static_cast<uint32_t>(text.size())});
+            stringData_.append(text);
+            ids_.emplace(std::string(text), id);
+            return id;
+        }
+
+        uint32_t Intern(Symbol symbol) { return Intern(symbol.View()); }
+
+        void AddSource(const BlockBakedCache::SourceFile &source)
+        {
+            sources_.push_back({source.folder, Intern(source.name), source.size, source.mtime, source.crc, 0});
+        }
+
+        void AddBlock(const std::string &name, const BlockJsonData &data)
+        {
+            BakedBlock block{};
+            block.name = Intern(name);
+            block.stateLoaded = data.state.wasLoaded;
+            block.definitionLoaded = data.definition.wasLoaded;
+            block.isTransparent = data.definition.isTransparent;
+            block.isSolid = data.definition.isSolid;
+            block.isOpaque = data.definition.isOpaque;
+            block.isFullCube = data.definition.isFullCube;
+
+            AddKeyValues(data.state.properties, block.propertyFirst, block.propertyCount);
+            AddKeyValues(data.state.variants, block.variantFirst, block.variantCount);
+
+            block.modelFirst = static_cast<uint32_t>(models_.size());
+            block.modelCount = static_cast<uint32_t>(data.models.size());
+
+            // Reserve the model slots first: their elements and textures follow.
+            models_.resize(models_.size() + data.models.size());
+            uint32_t slot = block.modelFirst;
+            for (const auto *model : SortedByKey(data.models))
+                models_[slot++] = MakeModel(model->first, model->second);
+
+            blocks_.push_back(block);
+        }
+
+        std::vector<std::byte> Finish()
+        {
+            BakeHeader header{};
+            std::memcpy(header.magic, BAKE_MAGIC, sizeof(BAKE_MAGIC));
+            header.version = BlockBakedCache::VERSION;
+            header.headerSize = sizeof(BakeHeader);
+            header.sectionCount = SectionCount;
+
+            uint64_t offset = Align8(sizeof(BakeHeader));
+            auto place = [&](Section section, uint64_t count, uint64_t bytes)
+            {
+                header.sections[section] = {offset, count};
+                offset = Align8(offset + bytes);
+            };
+
+            place(StringIndex, strings_.size(), strings_.size() * sizeof(BakedString));
+            place(StringData, stringData_.size(), stringData_.size());
+            place(Sources, sources_.size(), sources_.size() * sizeof(BakedSource));
+            place(Blocks, blocks_.size(), blocks_.size() * sizeof(BakedBlock));
+            place(KeyValues, keyValues_.size(), keyValues_.size() * sizeof(BakedKeyValue));
+            place(Models, models_.size(), models_.size() * sizeof(BakedModel));
+            place(Elements, elements_.size(), elements_.size() * sizeof(BakedElement));
+            place(Faces, faces_.size(), faces_.size() * sizeof(BakedFace));
+            place(Blobs, blobs_.size(), blobs_.size());
+            header.fileSize = offset;
+
+            std::vector<std::byte> out(offset);
+            auto copy = [&](Section section, const void *src, size_t bytes)
+            {
+                if (bytes > 0)
+                    std::memcpy(out.data() + header.sections[section].offset, src, bytes);
+            };
+
+            copy(StringIndex, strings_.data(), strings_.size() * sizeof(BakedString));
+            copy(StringData, stringData_.data(), stringData_.size());
+            copy(Sources, sources_.data(), sources_.size() * sizeof(BakedSource));
+            copy(Blocks, blocks_.data(), blocks_.size() * sizeof(BakedBlock));
+            copy(KeyValues, keyValues_.data(), keyValues_.size() * sizeof(BakedKeyValue));
+            copy(Models, models_.data(), models_.size() * sizeof(BakedModel));
+            copy(Elements, elements_.data(), elements_.size() * sizeof(BakedElement));
+            copy(Faces, faces_.data(), faces_.size() * sizeof(BakedFace));
+            copy(Blobs, blobs_.data(), blobs_.size());
+
+            header.payloadCrc = Crc32(out.data() + sizeof(BakeHeader), out.size() - sizeof(BakeHeader));
+            std::memcpy(out.data(), &header, sizeof(BakeHeader));
+            return out;
+        }
+
+    private:
+        template <typename Map>
+        void AddKeyValues(const Map &map, uint32_t &first, uint32_t &count)
+        {
+            first = static_cast<uint32_t>(keyValues_.size());
+            count = static_cast<uint32_t>(map.size());
+            for (const auto *kv : SortedByKey(map))
+                keyValues_.push_back({Intern(kv->first), Intern(kv->second)});
+        }
+
+        BakedModel MakeModel(Symbol name, const BlockModel &model)
+        {
+            BakedModel baked{};
+            baked.name = Intern(name);
+            baked.wasLoaded = model.wasLoaded;
+            baked.isBlockbench = model.isBlockbench;
+
+            if (model.isBlockbench)
+            {
+                const auto &bb = std::get<BlockBenchModel>(model.data);
+                baked.formatVersion = Intern(bb.formatVersion);
+                baked.credit = Intern(bb.credit);
+                baked.parent = Intern("");
+                AddKeyValues(bb.textures, baked.textureFirst, baked.textureCount);
+
+                baked.elementFirst = static_cast<uint32_t>(elements_.size());
+                baked.elementCount = static_cast<uint32_t>(bb.elements.size());
+                for (const BlockElement &element : bb.elements)
+                    elements_.push_back(MakeElement(element));
+            }
+            else
+            {
+                const auto &def = std::get<DefaultTemplateModel>(model.data);
+                baked.formatVersion = Intern(def.formatVersion);
+                baked.credit = Intern("");
+                baked.parent = Intern(def.parent);
+                AddKeyValues(def.textures, baked.textureFirst, baked.textureCount);
+
+                // Vanilla elements stay raw JSON in memory; keep them as CBOR.
+                if (!def.elements.is_null())
+                {
+                    const std::vector<std::uint8_t> cbor = json::to_cbor(def.elements);
+                    baked.hasRawElements = 1;
+                    baked.blobOffset = static_cast<uint32_t>(blobs_.size());
+                    baked.blobSize = static_cast<uint32_t>(cbor.size());
+                    const auto *bytes = reinterpret_cast<const std::byte *>(cbor.data());
+                    blobs_.insert(blobs_.end(), bytes, bytes + cbor.size());
+                }
+            }
+            return baked;
+        }
+
+        BakedElement MakeElement(const BlockElement &element)
+        {
+            BakedElement baked{};
+            std::copy(element.from.begin(), element.from.end(), baked.from);
+            std::copy(element.to.begin(), element.to.end(), baked.to);
+            baked.angle = element.rotation.angle;
+            baked.axis = Intern(element.rotation.axis);
+            std::copy(element.rotation.origin.begin(), element.rotation.origin.end(), baked.origin);
+
+            baked.faceFirst = static_cast<uint32_t>(faces_.size());
+            baked.faceCount = static_cast<uint32_t>(element.faces.size());
+            for (const auto *face : SortedByKey(element.faces))
+            {
+                BakedFace f{};
+                f.name = Intern(face->first);
+                std::copy(face->second.uv.begin(), face->second.uv.end(), f.uv);
+                f.texture = Intern(face->second.texture);
+                f.cullface = Intern(face->second.cullface);
+                faces_.push_back(f);
+            }
+            return baked;
+        }
+
+        std::unordered_map<std::string, uint32_t> ids_;
+        std::vector<BakedString> strings_;
+        std::string stringData_;
+        std::vector<BakedSource> sources_;
+        std::vector<BakedBlock> blocks_;
+        std::vector<BakedKeyValue> keyValues_;
+        std::vector<BakedModel> models_;
+        std::vector<BakedElement> elements_;
+        std::vector<BakedFace> faces_;
+        std::vector<std::byte> blobs_;
+    };
+
+    /**
+     * @brief Bounds-checked view of a mapped blob.
+     *
+     * Every table and index is checked before use, so a corrupt file throws
+     * instead of reading outside the mapping.
+     */
+    class BakeReader
+    {
+    public:
+        BakeReader(const std::byte *data, size_t size) : data_(data), size_(size)
+        {
+            if (size_ < sizeof(BakeHeader))
+                throw std::runtime_error("file too small");
+
+            std::memcpy(&header_, data_, sizeof(BakeHeader));
+            if (std::memcmp(header_.magic, BAKE_MAGIC, sizeof(BAKE_MAGIC)) != 0)
+                throw std::runtime_error("bad magic");
+            if (header_.version != BlockBakedCache::VERSION || header_.headerSize != sizeof(BakeHeader) ||
+                header_.sectionCount != SectionCount)
+                throw std::runtime_error("unsupported version");
+            if (header_.fileSize != size_)
+                throw std::runtime_error("truncated file");
+            if (Crc32(data_ + sizeof(BakeHeader), size_ - sizeof(BakeHeader)) != header_.payloadCrc)
+                throw std::runtime_error("checksum mismatch");
+
+            strings_ = Table<BakedString>(StringIndex);
+            stringData_ = Table<char>(StringData);
+            blobs_ = Table<std::byte>(Blobs);
+        }
+
+        template <typename T>
+        std::span<const T> Table(Section section) const
+        {
+            const SectionRef &ref = header_.sections[section];
+            if (ref.offset % alignof(T) != 0 || ref.offset > size_ || ref.count > (size_ - ref.offset) / sizeof(T))
+                throw std::runtime_error("section out of bounds");
+            return {reinterpret_cast<const T *>(data_ + ref.offset), static_cast<size_t>(ref.count)};
+        }
+
+        template <typename T>
+        static std::span<const T> Range(std::span<const T> table, uint32_t first, uint32_t count)
+        {
+            if (first > table.size() || count > table.size() - first)
+                throw std::runtime_error("index out of bounds");
+            return table.subspan(first, count);
+        }
+
+        std::string_view String(uint32_t id) const
+        {
+            if (id >= strings_.size())
+                throw std::runtime_error("string id out of bounds");
+            const BakedString &s = strings_[id];
+            if (s.offset > stringData_.size() || s.length > stringData_.size() - s.offset)
+                throw std::runtime_error("string out of bounds");
+            return {stringData_.data() + s.offset, s.length};
+        }
+
+        std::span<const std::byte> Blob(uint32_t offset, uint32_t size) const
+        {
+            return Range(blobs_, offset, size);
+        }
+
+    private:
+        const std::byte *data_;
+        size_t size_;
+        BakeHeader header_{};
+        std::span<const BakedString> strings_;
+        std::span<const char> stringData_;
+        std::span<const std::byte> blobs_;
+    };
+
+    template <typename Map>
+    void ReadKeyValues(const BakeReader &reader, std::span<const BakedKeyValue> table,
+                       uint32_t first, uint32_t count, Map &out)
+    {
+        out.reserve(count);
+        for (const BakedKeyValue &kv : BakeReader::Range(table, first, count))
+            out.emplace(typename Map::key_type(reader.String(kv.key)), typename Map::mapped_type(reader.String(kv.value)));
+    }
+}
+
+BlockBakedCache::BlockBakedCache(ILogger &logger)
+    : logger_(logger)
+{
+}
+
+BlockBakedCache::Manifest BlockBakedCache::BuildManifest(const BlockJsonFolders &folders)
+{
+    Manifest manifest;
+    const fs::path *paths[] = {&folders.states, &folders.definitions, &folders.models};
+
+    for (uint32_t folder = 0; folder < 3; ++folder)
+    {
+        for (const auto &entry : fs::directory_iterator(*paths[folder]))
+        {
+            if (!entry.is_regular_file() || entry.path().extension() != ".json")
+                continue;
+
+            SourceFile source;
+            source.folder = folder;
+            source.name = entry.path().filename().string();
+            source.size = entry.file_size();
+            source.mtime = ToTicks(entry.last_write_time());
+            if (!HashFile(entry.path(), source.crc))
+                continue; // unreadable now: the JSON load reports it
+            manifest.push_back(std::move(source));
+        }
+    }
+    return manifest;
+}
+
+bool BlockBakedCache::ManifestMatches(const Manifest &manifest, const BlockJsonFolders &folders) const
+{
+    std::array<std::unordered_map<std::string_view, const SourceFile *>, 3> byName;
+    for (const SourceFile &source : manifest)
+    {
+        if (source.folder >= byName.size())
+            return false;
+        byName[source.folder].emplace(source.name, &source);
+    }
+
+    const fs::path *paths[] = {&folders.states, &folders.definitions, &folders.models};
+    size_t seen = 0;
+    size_t rehashed = 0;
+
+    for (uint32_t folder = 0; folder < 3; ++folder)
+    {
+        std::error_code ec;
+        for (fs::directory_iterator it(*paths[folder], ec), end; !ec && it != end; it.increment(ec))
+        {
+            const fs::directory_entry &entry = *it;
+            if (!entry.is_regular_file() || entry.path().extension() != ".json")
+                continue;
+
+            const std::string name = entry.path().filename().string();
+            auto found = byName[folder].find(name);
+            if (found == byName[folder].end())
+            {
+                LOG_INFO(logger_, LogCategory::Json, "Baked block cache is stale: new file {}", entry.path().string());
+                return false;
+            }
+
+            const SourceFile &source = *found->second;
+            if (entry.file_size() != source.size)
+            {
+                LOG_INFO(logger_, LogCategory::Json, "Baked block cache is stale: {} changed", entry.path().string());
+                return false;
+            }
+
+            if (ToTicks(entry.last_write_time()) != source.mtime)
+            {
+                uint32_t crc = 0;
+                if (!HashFile(entry.path(), crc) || crc != source.crc)
+                {
+                    LOG_INFO(logger_, LogCategory::Json, "Baked block cache is stale: {} changed", entry.path().string());
+                    return false;
+                }
+                ++rehashed;
+            }
+            ++seen;
+        }
+        if (ec)
+            return false;
+    }
+
+    if (seen != manifest.size())
+    {
+        LOG_INFO(logger_, LogCategory::Json, "Baked block cache is stale: {} source files removed", manifest.size() - seen);
+        return false;
+    }
+
+    if (rehashed > 0)
+        LOG_DEBUG(logger_, LogCategory::Json, "Baked block cache: {} touched files re-hashed, contents unchanged", rehashed);
+    return true;
+}
+
+bool BlockBakedCache::TryLoad(const fs::path &bakePath,
+                              const BlockJsonFolders &folders,
+                              std::unordered_map<std::string, BlockJsonData> &out)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    std::error_code ec;
+    if (!fs::exists(bakePath, ec))
+        return false;
+
+    MappedFile file;
+    if (!file.Open(bakePath, MappedFile::Access::ReadOnly))
+    {
+        LOG_WARNING(logger_, LogCategory::Json, "Cannot map baked block cache {}", bakePath.string());
+        return false;
+    }
+
+    try
+    {
+        BakeReader reader(file.Data(), file.Size());
+
+        Manifest manifest;
+        const auto sources = reader.Table<BakedSource>(Sources);
+        manifest.reserve(sources.size());
+        for (const BakedSource &s : sources)
+            manifest.push_back({s.folder, std::string(reader.String(s.name)), s.size, s.mtime, s.crc});
+
+        if (!ManifestMatches(manifest, folders))
+            return false;
+
+        const auto blocks = reader.Table<BakedBlock>(Blocks);
+        const auto keyValues = reader.Table<BakedKeyValue>(KeyValues);
+        const auto models = reader.Table<BakedModel>(Models);
+        const auto elements = reader.Table<BakedElement>(Elements);
+        const auto faces = reader.Table<BakedFace>(Faces);
+
+        std::unordered_map<std::string, BlockJsonData> result;
+        result.reserve(blocks.size());
+
+        for (const BakedBlock &block : blocks)
+        {
+            BlockJsonData &data = result[std::string(reader.String(block.name))];
+
+            data.state.wasLoaded = block.stateLoaded != 0;
+            ReadKeyValues(reader, keyValues, block.propertyFirst, block.propertyCount, data.state.properties);
+            ReadKeyValues(reader, keyValues, block.variantFirst, block.variantCount, data.state.variants);
+
+            data.definition.wasLoaded = block.definitionLoaded != 0;
+            data.definition.isTransparent = block.isTransparent != 0;
+            data.definition.isSolid = block.isSolid != 0;
+            data.definition.isOpaque = block.isOpaque != 0;
+            data.definition.isFullCube = block.isFullCube != 0;
+
+            data.models.reserve(block.modelCount);
+            for (const BakedModel &baked : BakeReader::Range(models, block.modelFirst, block.modelCount))
+            {
+                BlockModel &model = data.models[Symbol(reader.String(baked.name))];
+                model.wasLoaded = baked.wasLoaded != 0;
+                model.isBlockbench = baked.isBlockbench != 0;
+
+                if (model.isBlockbench)
+                {
+                    BlockBenchModel bb;
+                    bb.formatVersion = reader.String(baked.formatVersion);
+                    bb.credit = reader.String(baked.credit);
+                    ReadKeyValues(reader, keyValues, baked.textureFirst, baked.textureCount, bb.textures);
+
+                    bb.elements.reserve(baked.elementCount);
+                    for (const BakedElement &e : BakeReader::Range(elements, baked.elementFirst, baked.elementCount))
+                    {
+                        BlockElement &element = bb.elements.emplace_back();
+                        std::copy(std::begin(e.from), std::end(e.from), element.from.begin());
+                        std::copy(std::begin(e.to), std::end(e.to), element.to.begin());
+                        element.rotation.angle = e.angle;
+                        element.rotation.axis = reader.String(e.axis);
+                        std::copy(std::begin(e.origin), std::end(e.origin), element.rotation.origin.begin());
+
+                        element.faces.reserve(e.faceCount);
+                        for (const BakedFace &f : BakeReader::Range(faces, e.faceFirst, e.faceCount))
+                        {
+                            BlockFace &face = element.faces[std::string(reader.String(f.name))];
+                            std::copy(std::begin(f.uv), std::end(f.uv), face.uv.begin());
+                            face.texture = Symbol(reader.String(f.texture));
+                            face.cullface = reader.String(f.cullface);
+                        }
+                    }
+                    model.data = std::move(bb);
+                }
+                else
+                {
+                    DefaultTemplateModel def;
+                    def.formatVersion = reader.String(baked.formatVersion);
+                    def.parent = reader.String(baked.parent);
+                    ReadKeyValues(reader, keyValues, baked.textureFirst, baked.textureCount, def.textures);
+
+                    if (baked.hasRawElements)
+                    {
+                        const auto blob = reader.Blob(baked.blobOffset, baked.blobSize);
+                        const auto *bytes = reinterpret_cast<const std::uint8_t *>(blob.data());
+                        def.elements = json::from_cbor(bytes, bytes + blob.size());
+                    }
+                    model.data = std::move(def);
+                }
+            }
+        }
+
+        out = std::move(result);
+    }
+    catch (const std::exception &e)
+    {
+        LOG_WARNING(logger_, LogCategory::Json, "Ignoring baked block cache {}: {}", bakePath.string(), e.what());
+        return false;
+    }
+
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    LOG_INFO(logger_, LogCategory::Json, "Loaded {} blocks from baked cache in {:.1f} ms", out.size(), ms);
+    return true;
+}
+
+bool BlockBakedCache::Save(const fs::path &bakePath,
+                           const Manifest &manifest,
+                           const std::unordered_map<std::string, BlockJsonData> &blocks)
+{
+    BakeWriter writer;
+    for (const SourceFile &source : manifest)
+        writer.AddSource(source);
+    for (const auto *block : SortedByKey(blocks))
+        writer.AddBlock(block->first, block->second);
+
+    const std::vector<std::byte> blob = writer.Finish();
+
+    fs::path tmpPath = bakePath;
+    tmpPath += ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(blob.data()), static_cast<std::streamsize>(blob.size()));
+        if (!out)
+        {
+            LOG_WARNING(logger_, LogCategory::Json, "Cannot write baked block cache {}", tmpPath.string());
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tmpPath, bakePath, ec);
+    if (ec)
+    {
+        LOG_WARNING(logger_, LogCategory::Json, "Cannot replace baked block cache {}: {}", bakePath.string(), ec.message());
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+
+    LOG_INFO(logger_, LogCategory::Json, "Baked {} blocks ({} source files, {} KB) to {}",
+             blocks.size(), manifest.size(), blob.size() / 1024, bakePath.string());
+    return true;
+}
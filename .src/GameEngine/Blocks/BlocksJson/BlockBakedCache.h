@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BlockJsonData.h"
+#include "ILogger.h"
+
+/**
+ * @brief Source folders of the block JSON files, in manifest order.
+ */
+struct BlockJsonFolders
+{
+    std::filesystem::path states;      ///< Folder index 0.
+    std::filesystem::path definitions; ///< Folder index 1.
+    std::filesystem::path models;      ///< Folder index 2.
+};
+
+/**
+ * @brief Binary "baked" copy of the validated block JSON data.
+ *
+ * After a successful JSON load the cache is written to a single versioned
+ * blob: every name and texture reference is interned once in a string table
+ * and all records (blocks, key/value pairs, models, elements, faces) are flat
+ * arrays that refer to each other by index. At startup the blob is mapped
+ * with @ref MappedFile and decoded straight from the mapping, which skips
+ * opening thousands of files and the JSON DOM altogether.
+ *
+ * The blob embeds a manifest of the source files (folder, name, size, mtime,
+ * CRC-32). It is only used when the current folders still match: a file
+ * whose size and mtime are unchanged is trusted, a file whose mtime moved
+ * but size did not (e.g. a fresh checkout) is re-hashed. Anything else is a
+ * miss and the caller falls back to JSON.
+ *
+ * @note The layout is native-endian; a blob from another platform fails the
+ *       header check and is simply rebuilt.
+ */
+class BlockBakedCache
+{
+public:
+    /** @brief Bumped on every layout change; older blobs are ignored. */
+    static constexpr uint32_t VERSION = 2;
+
+    /** @brief One source file recorded in the manifest. */
+    struct SourceFile
+    {
+        uint32_t folder = 0; ///< 0 = states, 1 = definitions, 2 = models.
+        std::string name;    ///< File name inside the folder.
+        uint64_t size = 0;
+        int64_t mtime = 0;   ///< std::filesystem::file_time_type ticks.
+        uint32_t crc = 0;    ///< CRC-32 of the file contents.
+    };
+
+    using Manifest = std::vector<SourceFile>;
+
+    explicit BlockBakedCache(ILogger &logger);
+
+    /**
+     * @brief Records every `.json` file of @p folders.
+     *
+     * Reads each file once to hash it. Take the manifest before loading the
+     * JSON so that a file edited during the load invalidates the blob.
+     *
+     * @throws std::filesystem::filesystem_error If a directory cannot be accessed.
+     */
+    static Manifest BuildManifest(const BlockJsonFolders &folders);
+
+    /**
+     * @brief Loads @p out from the blob at @p bakePath if it matches @p folders.
+     *
+     * Never throws: a missing, stale, corrupt or foreign blob returns false.
+     */
+    bool TryLoad(const std::filesystem::path &bakePath,
+                 const BlockJsonFolders &folders,
+                 std::unordered_map<std::string, BlockJsonData> &out);
+
+    /**
+     * @brief Writes @p blocks and @p manifest to @p bakePath.
+     *
+     * The blob is written to a temporary file and renamed over the old one,
+     * so a crash mid-write never leaves a truncated cache behind.
+     *
+     * @return false if the file could not be written (logged as a warning).
+     */
+    bool Save(const std::filesystem::path &bakePath,
+              const Manifest &manifest,
+              const std::unordered_map<std::string, BlockJsonData> &blocks);
+
+private:
+    /** @brief Checks the embedded manifest against the files on disk. */
+    bool ManifestMatches(const Manifest &manifest, const BlockJsonFolders &folders) const;
+
+    ILogger &logger_;
+};
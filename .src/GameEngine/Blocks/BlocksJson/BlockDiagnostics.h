@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Symbol.h"
+
+/**
+ * @brief Kind of problem found while loading or validating a block.
+ */
+enum class BlockDiagnosticKind
+{
+    ParseError,        ///< A JSON file could not be opened, parsed or read into its struct.
+    MissingBlock,      ///< A built-in block type has no data at all.
+    MissingState,      ///< The block has no state file.
+    InvalidState,      ///< The state file failed @c Validate().
+    MissingDefinition, ///< The block has no definition file.
+    InvalidDefinition, ///< The definition file failed @c Validate().
+    NoModels,          ///< The block has no model files.
+    MissingModel,      ///< A model entry has no loaded file.
+    InvalidModel       ///< A model file failed @c Validate().
+};
+
+/** @brief Returns the enumerator name, e.g. `"InvalidModel"`. */
+inline std::string_view ToString(BlockDiagnosticKind kind)
+{
+    switch (kind)
+    {
+    case BlockDiagnosticKind::ParseError:
+        return "ParseError";
+    case BlockDiagnosticKind::MissingBlock:
+        return "MissingBlock";
+    case BlockDiagnosticKind::MissingState:
+        return "MissingState";
+    case BlockDiagnosticKind::InvalidState:
+        return "InvalidState";
+    case BlockDiagnosticKind::MissingDefinition:
+        return "MissingDefinition";
+    case BlockDiagnosticKind::InvalidDefinition:
+        return "InvalidDefinition";
+    case BlockDiagnosticKind::NoModels:
+        return "NoModels";
+    case BlockDiagnosticKind::MissingModel:
+        return "MissingModel";
+    case BlockDiagnosticKind::InvalidModel:
+        return "InvalidModel";
+    }
+    return "Unknown";
+}
+
+/**
+ * @brief One problem found in a block's JSON files.
+ */
+struct BlockDiagnostic
+{
+    BlockDiagnosticKind kind;    ///< What went wrong.
+    std::string blockName;       ///< Affected block.
+    Symbol model;                ///< Affected model; empty unless the problem is in one model.
+    std::filesystem::path file;  ///< Offending file; empty if not known (e.g. a missing file).
+    std::string message;         ///< Human-readable description, as logged.
+};
+
+/**
+ * @brief Outcome of the validation pass of @ref BlockJsonDataCache.
+ *
+ * Only filled by the initial load; hot reloads log their problems and keep
+ * the previous version of a block instead.
+ */
+struct BlockDiagnosticsReport
+{
+    /** @brief Every problem found, grouped by block name. */
+    std::vector<BlockDiagnostic> errors;
+
+    /** @brief Blocks replaced by the fallback "missing" model, sorted by name. */
+    std::vector<std::string> quarantined;
+
+    size_t blocksChecked = 0; ///< Number of blocks validated.
+    size_t shards = 0;        ///< Number of shards that validated them, the calling thread included.
+    double validateMs = 0;    ///< Wall time of the validation pass.
+
+    /** @brief @c true if no problem was found. */
+    bool Ok() const noexcept { return errors.empty(); }
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+struct BlockJsonData;
+
+/**
+ * @brief Runtime numeric block id.
+ *
+ * Ids below @c BlockType::Count equal the @c BlockType value; blocks that
+ * only exist in the resource pack get the following ids in name order.
+ * Ids are stable for the lifetime of the cache, including hot reloads.
+ */
+using BlockId = uint16_t;
+
+/**
+ * @brief Compact per-block record for hot paths such as meshing.
+ *
+ * Stored in a dense array indexed by @ref BlockId, so a lookup is one
+ * bounds check and one load, with no string building or hashing.
+ *
+ * @see BlockJsonDataCache::GetHot
+ */
+struct BlockHotData
+{
+    /** @brief Bits of @ref flags, copied from @ref BlockDefinition. */
+    enum Flag : uint8_t
+    {
+        Transparent = 1 << 0, ///< Lets light pass through.
+        Solid = 1 << 1,       ///< Has a collision box.
+        Opaque = 1 << 2,      ///< Fully blocks light; hides neighbour faces.
+        FullCube = 1 << 3     ///< Occupies the whole cell.
+    };
+
+    /** @brief Full JSON data for slower paths; never @c nullptr in a returned entry. */
+    const BlockJsonData *data = nullptr;
+
+    /** @brief Id of this block (its index in the table). */
+    BlockId id = 0;
+
+    /** @brief Combination of @ref Flag bits. */
+    uint8_t flags = 0;
+
+    /** @brief Number of models, saturated at 255. */
+    uint8_t modelCount = 0;
+
+    /** @brief Returns @c true if every bit of @p flag is set. */
+    constexpr bool Has(Flag flag) const noexcept { return (flags & flag) == flag; }
+};
+
+static_assert(sizeof(BlockHotData) <= 16, "BlockHotData must stay compact");
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <unordered_map>
+#include <string>
+#include <sstream>
+#include <format>
+
+#include "BlockModelConfig.h"
+#include "BlockStateConfig.h"
+#include "BlockDefinitionConfig.h"
+#include "BlockJsonSax.h"
+
+#include "IDebugPrintable.h"
+#include "DebugColors.h"
+
+/**
+ * @brief Holds all JSON-parsed data related to a single block type.
+ *
+ * This structure aggregates all information about a block loaded from
+ * its configuration JSON files, including its state, definition, and
+ * associated models.
+ *
+ * @struct BlockJsonData
+ * @see BlockState
+ * @see BlockDefinition
+ * @see BlockModel
+ */
+struct BlockJsonData : public IDebugPrintable
+{
+    /** @brief Describes the possible or current states of the block. */
+    BlockState state;
+
+    /** @brief Defines physical and visual properties of the block. */
+    BlockDefinition definition;
+
+    /**
+     * @brief Maps model names to their corresponding block models.
+     *
+     * A single block may have multiple models representing different
+     * orientations, variants, or states.
+     *
+     * Each model name must start with the block name followed by an underscore.
+     * Example: `log_waterfilled`.
+     */
+    std::unordered_map<Symbol, BlockModel> models;
+
+    /// @copydoc IDebugPrintable::ToShortString
+    std::string ToShortString() const override
+    {
+        return std::format("BlockJsonData(models={}, state={}, def={})",
+                           models.size(),
+                           state.ToShortString(),
+                           definition.ToShortString());
+    }
+
+    /// @copydoc IDebugPrintable::ToPrettyString
+    std::string ToPrettyString() const override
+    {
+        using namespace DebugHelpers;
+        using namespace DebugColors;
+
+        std::ostringstream ss;
+        ss << Bold << "BlockJsonData" << Reset << " " << Dim << "{\n"
+           << Reset;
+
+        // --- Definition ---
+        ss << "  " << BrightMagenta << "Definition:" << Reset << "\n";
+        {
+            std::string defStr = definition.ToPrettyString();
+            std::istringstream defStream(defStr);
+            std::string line;
+            while (std::getline(defStream, line))
+                ss << "    " << line << '\n';
+        }
+
+        // --- State ---
+        ss << "  " << BrightMagenta << "State:" << Reset << "\n";
+        {
+            std::string stateStr = state.ToPrettyString();
+            std::istringstream stateStream(stateStr);
+            std::string line;
+            while (std::getline(stateStream, line))
+                ss << "    " << line << '\n';
+        }
+
+        // --- Models ---
+        ss << "  " << BrightMagenta << "Models:" << Reset << "\n";
+        if (models.empty())
+        {
+            ss << "    (none)\n";
+        }
+        else
+        {
+            for (const auto &[key, model] : models)
+            {
+                ss << std::format("    [{}{}{}]:\n", Magenta, key, Reset);
+                std::string modelStr = model.ToPrettyString();
+                std::istringstream modelStream(modelStr);
+                std::string line;
+                while (std::getline(modelStream, line))
+                    ss << "      " << line << '\n';
+            }
+        }
+
+        ss << Dim << "}" << Reset;
+        return ss.str();
+    }
+};
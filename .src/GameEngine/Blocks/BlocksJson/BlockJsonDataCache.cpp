@@ -1,27 +1,48 @@
 #include "BlockJsonDataCache.h"
+#include "LogMacros.h"
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <limits>
 #include <sstream>
 
 // Implementation of non-template member functions
 
-BlockJsonDataCache::BlockJsonDataCache(ILogger &logger, const IPathProvider &paths)
-    : logger_(logger), paths_(paths)
+namespace
+{
+    // Per-statement budget: a broken resource pack must not flood the log.
+    constexpr uint32_t VALIDATION_ERRORS_PER_SECOND = 20;
+
+    // Texture of the quarantine model; intentionally absent from resource packs.
+    constexpr const char *MISSING_TEXTURE = "block/missing";
+}
+
+BlockJsonDataCache::BlockJsonDataCache(ILogger &logger, const IPathProvider &paths,
+                                       const BlockJsonDataCacheConfig &config)
+    : logger_(logger), paths_(paths), config_(config)
 {
     Init();
 }
 
-BlockJsonDataCache &BlockJsonDataCache::Instance(ILogger &logger, const IPathProvider &paths)
+BlockJsonDataCache::~BlockJsonDataCache()
 {
-    static BlockJsonDataCache instance(logger, paths);
+    DisableHotReload();
+}
+
+BlockJsonDataCache &BlockJsonDataCache::Instance(ILogger &logger, const IPathProvider &paths,
+                                                 const BlockJsonDataCacheConfig &config)
+{
+    static BlockJsonDataCache instance(logger, paths, config);
     return instance;
 }
 
 std::optional<std::reference_wrapper<const BlockJsonData>>
 BlockJsonDataCache::Get(const std::string &name) const
 {
-    if (auto it = cache_.find(name); it != cache_.end())
-        return std::cref(it->second);
+    // The pointee outlives the snapshot: replaced versions are kept in replaced_.
+    if (auto data = GetShared(name))
+        return std::cref(*data);
 
     return std::nullopt;
 }
@@ -29,166 +50,674 @@ BlockJsonDataCache::Get(const std::string &name) const
 std::optional<std::reference_wrapper<const BlockJsonData>>
 BlockJsonDataCache::Get(BlockType type) const
 {
-    return Get(ToString(type));
+    if (const BlockHotData *hot = GetHot(type))
+        return std::cref(*hot->data);
+
+    return std::nullopt;
 }
 
-size_t BlockJsonDataCache::GetLoadedCount() const noexcept
+const BlockHotData *BlockJsonDataCache::GetHot(BlockType type) const noexcept
 {
-    return cache_.size();
+    return GetHot(static_cast<BlockId>(type));
 }
 
-void BlockJsonDataCache::LoadAllStates()
+const BlockHotData *BlockJsonDataCache::GetHot(BlockId id) const noexcept
 {
-    namespace fs = std::filesystem;
-    for (const auto &entry : fs::directory_iterator(blockStatesFolder))
-    {
-        if (!entry.is_regular_file() || entry.path().extension() != ".json")
-            continue;
+    const Snapshot *snapshot = snapshot_.load(std::memory_order_acquire);
+    if (id >= snapshot->dense.size())
+        return nullptr;
 
-        std::string name = entry.path().stem().string();
-        cache_[name].state = LoadJsonFile<BlockState>(entry.path());
-    }
+    const BlockHotData &hot = snapshot->dense[id];
+    return hot.data ? &hot : nullptr;
 }
 
-void BlockJsonDataCache::LoadAllDefinitions()
+size_t BlockJsonDataCache::GetIdCount() const noexcept
 {
-    namespace fs = std::filesystem;
-    for (const auto &entry : fs::directory_iterator(blockDefinitionsFolder))
+    return snapshot_.load(std::memory_order_acquire)->dense.size();
+}
+
+std::string_view BlockJsonDataCache::GetName(BlockId id) const noexcept
+{
+    const Snapshot *snapshot = snapshot_.load(std::memory_order_acquire);
+    return id < snapshot->names.size() ? snapshot->names[id] : std::string_view{};
+}
+
+std::optional<BlockId> BlockJsonDataCache::GetId(const std::string &name) const
+{
+    return ReadMaps([&](const Snapshot &snapshot) -> std::optional<BlockId>
+                    {
+                        if (auto it = snapshot.ids.find(name); it != snapshot.ids.end())
+                            return it->second;
+                        return std::nullopt;
+                    });
+}
+
+std::shared_ptr<const BlockJsonData> BlockJsonDataCache::GetShared(const std::string &name) const
+{
+    return ReadMaps([&](const Snapshot &snapshot) -> std::shared_ptr<const BlockJsonData>
+                    {
+                        if (auto it = snapshot.blocks.find(name); it != snapshot.blocks.end())
+                            return it->second;
+                        return nullptr;
+                    });
+}
+
+BlockModelHandle BlockJsonDataCache::AcquireModel(Symbol name) const
+{
+    if (modelStore_)
     {
-        if (!entry.is_regular_file() || entry.path().extension() != ".json")
-            continue;
+        if (BlockModelHandle handle = modelStore_->Acquire(name))
+            return handle;
+    }
+
+    // Snapshot models: all models in eager mode, quarantine models in lazy mode.
+    // Model names start with their block name: `blockName_modelName`.
+    const std::string_view text = name.View();
+    auto data = GetShared(std::string(text.substr(0, text.find('_'))));
+    if (!data)
+        return {};
+
+    auto it = data->models.find(name);
+    if (it == data->models.end())
+        return {};
 
-        std::string name = entry.path().stem().string();
-        cache_[name].definition = LoadJsonFile<BlockDefinition>(entry.path());
+    return BlockModelHandle(nullptr, name, std::shared_ptr<const BlockModel>(std::move(data), &it->second));
+}
+
+std::vector<Symbol> BlockJsonDataCache::GetModelNames(const std::string &blockName) const
+{
+    std::vector<Symbol> names;
+    if (modelStore_)
+        names = modelStore_->GetModelNames(blockName);
+
+    if (auto data = GetShared(blockName); data && !data->models.empty())
+    {
+        names.reserve(names.size() + data->models.size());
+        for (const auto &[name, model] : data->models)
+            names.push_back(name);
+        std::sort(names.begin(), names.end(), [](Symbol a, Symbol b) { return a.View() < b.View(); });
     }
+    return names;
 }
 
-void BlockJsonDataCache::LoadAllModels()
+BlockModelStore::Stats BlockJsonDataCache::GetModelStats() const
 {
-    namespace fs = std::filesystem;
-    for (const auto &entry : fs::directory_iterator(blockModelsFolder))
+    return modelStore_ ? modelStore_->GetStats() : BlockModelStore::Stats{};
+}
+
+size_t BlockJsonDataCache::GetLoadedCount() const noexcept
+{
+    return ReadMaps([](const Snapshot &snapshot) { return snapshot.blocks.size(); });
+}
+
+std::unordered_map<std::string, BlockJsonData> BlockJsonDataCache::LoadAllBlocks(std::vector<BlockDiagnostic> &loadErrors)
+{
+    BlockJsonLoader loader(logger_, config_);
+    auto blocks = loader.LoadAll(blockStatesFolder, blockDefinitionsFolder, blockModelsFolder);
+    loadErrors = loader.GetLastErrors();
+    return blocks;
+}
+
+void BlockJsonDataCache::Publish(std::unordered_map<std::string, BlockJsonData> &&blocks)
+{
+    auto snapshot = std::make_unique<Snapshot>();
+    snapshot->blocks.reserve(blocks.size());
+    for (auto &[name, data] : blocks)
+        snapshot->blocks.emplace(name, std::make_shared<const BlockJsonData>(std::move(data)));
+
+    Store(std::move(snapshot));
+}
+
+void BlockJsonDataCache::BuildDenseTable(Snapshot &snapshot)
+{
+    // Built-in types keep their enum value as id, so GetHot(BlockType) needs no map.
+    if (snapshot.ids.empty())
+    {
+        for (auto type : AllBlockTypes())
+            snapshot.ids.emplace(ToString(type), static_cast<BlockId>(type));
+    }
+
+    std::vector<std::string> added;
+    for (const auto &[name, data] : snapshot.blocks)
     {
-        if (!entry.is_regular_file() || entry.path().extension() != ".json")
-            continue;
+        if (!snapshot.ids.contains(name))
+            added.push_back(name);
+    }
+    std::sort(added.begin(), added.end());
 
-        std::string filename = entry.path().stem().string();
-        auto underscorePos = filename.find('_');
-        if (underscorePos == std::string::npos)
-            continue;
+    if (snapshot.ids.size() + added.size() > std::numeric_limits<BlockId>::max())
+        throw std::runtime_error("BlockJsonDataCache: too many blocks for a 16-bit BlockId");
 
-        std::string blockName = filename.substr(0, underscorePos);
-        cache_[blockName].models[filename] = LoadJsonFile<BlockModel>(entry.path());
+    BlockId next = static_cast<BlockId>(BlockType::Count);
+    for (const auto &[name, id] : snapshot.ids)
+        next = std::max<BlockId>(next, id + 1);
+    for (std::string &name : added)
+        snapshot.ids.emplace(std::move(name), next++);
+
+    // Ids are never reused, so names_ only grows and earlier views stay valid.
+    names_.resize(next);
+    snapshot.dense.assign(next, {});
+    snapshot.names.assign(next, {});
+    for (const auto &[name, id] : snapshot.ids)
+    {
+        snapshot.dense[id].id = id;
+        if (names_[id].empty())
+            names_[id] = name;
+        snapshot.names[id] = names_[id];
+    }
+
+    for (const auto &[name, data] : snapshot.blocks)
+    {
+        BlockHotData &hot = snapshot.dense[snapshot.ids.at(name)];
+        const BlockDefinition &def = data->definition;
+
+        hot.data = data.get();
+        hot.flags = (def.isTransparent ? BlockHotData::Transparent : 0) |
+                    (def.isSolid ? BlockHotData::Solid : 0) |
+                    (def.isOpaque ? BlockHotData::Opaque : 0) |
+                    (def.isFullCube ? BlockHotData::FullCube : 0);
+        const size_t modelCount = data->models.size() + (modelStore_ ? modelStore_->GetModelNames(name).size() : 0);
+        hot.modelCount = static_cast<uint8_t>(std::min<size_t>(modelCount, 255));
     }
 }
 
-void BlockJsonDataCache::LoadAllBlocks()
+void BlockJsonDataCache::Store(std::unique_ptr<Snapshot> snapshot)
 {
-    LoadAllStates();
-    LoadAllDefinitions();
-    LoadAllModels();
+    BuildDenseTable(*snapshot);
+    snapshot_.store(snapshot.get(), std::memory_order_seq_cst);
+
+    if (current_)
+        retired_.push_back(std::move(current_));
+    current_ = std::move(snapshot);
+    ReleaseRetired();
 }
 
-void BlockJsonDataCache::ValidateAllBlocks() const
+void BlockJsonDataCache::ReleaseRetired()
 {
-    bool hasError = false;
+    if (released_ == retired_.size() || mapReaders_.load(std::memory_order_seq_cst) != 0)
+        return;
 
-    for (auto type : AllBlockTypes())
+    for (; released_ < retired_.size(); ++released_)
     {
-        std::string blockName = ToString(type);
-        if (blockName == "unknown" || blockName == "air")
-            continue;
-
-        auto it = cache_.find(blockName);
-        if (it == cache_.end())
+        Snapshot &old = *retired_[released_];
+        for (auto &[name, data] : old.blocks)
         {
-            logger_.Error("Missing BlockJsonData for: " + blockName);
-            hasError = true;
-            continue;
+            // Versions still in the current snapshot are kept alive by it.
+            auto it = current_->blocks.find(name);
+            if (it == current_->blocks.end() || it->second != data)
+                replaced_.push_back(std::move(data));
         }
 
-        const BlockJsonData &data = it->second;
-        bool ok = true;
+        // Swapped with empty maps so that the buckets are freed too.
+        decltype(old.blocks)().swap(old.blocks);
+        decltype(old.ids)().swap(old.ids);
+    }
+}
 
-        // --- State validation ---
-        if (!data.state.wasLoaded)
+bool BlockJsonDataCache::ValidateBlock(const std::string &blockName, const BlockJsonData &data,
+                                       std::vector<BlockDiagnostic> *errors) const
+{
+    bool ok = true;
+
+    // With a report the caller logs every entry; reloads log here, throttled.
+    auto fail = [&](BlockDiagnosticKind kind, Symbol model, std::filesystem::path file, std::string message)
+    {
+        if (errors)
+            errors->push_back({kind, blockName, model, std::move(file), std::move(message)});
+        else
+            LOG_ERROR_RATE_LIMITED(logger_, LogCategory::Json, VALIDATION_ERRORS_PER_SECOND, "{}", message);
+        ok = false;
+    };
+
+    // --- State validation ---
+    if (!data.state.wasLoaded)
+    {
+        fail(BlockDiagnosticKind::MissingState, {}, {}, std::format("Missing BlockState file for: {}", blockName));
+    }
+    else
+    {
+        try
         {
-            logger_.Error("Missing BlockState file for: " + blockName);
-            ok = false;
+            Validate(data.state);
         }
-        else
+        catch (const std::exception &e)
         {
-            try
-            {
-                Validate(data.state);
-            }
-            catch (const std::exception &e)
-            {
-                logger_.Error("Invalid BlockState for " + blockName + ": " + e.what());
-                ok = false;
-            }
+            fail(BlockDiagnosticKind::InvalidState, {}, blockStatesFolder / (blockName + ".json"),
+                 std::format("Invalid BlockState for {}: {}", blockName, e.what()));
         }
+    }
 
-        // --- Definition validation ---
-        if (!data.definition.wasLoaded)
+    // --- Definition validation ---
+    if (!data.definition.wasLoaded)
+    {
+        fail(BlockDiagnosticKind::MissingDefinition, {}, {},
+             std::format("Missing BlockDefinition file for: {}", blockName));
+    }
+    else
+    {
+        try
         {
-            logger_.Error("Missing BlockDefinition file for: " + blockName);
-            ok = false;
+            Validate(data.definition);
         }
-        else
+        catch (const std::exception &e)
         {
+            fail(BlockDiagnosticKind::InvalidDefinition, {}, blockDefinitionsFolder / (blockName + ".json"),
+                 std::format("Invalid BlockDefinition for {}: {}", blockName, e.what()));
+        }
+    }
+
+    // --- Models validation ---
+    if (modelStore_)
+    {
+        // Lazy models are validated by the store when first loaded.
+        if (modelStore_->GetModelNames(blockName).empty())
+            fail(BlockDiagnosticKind::NoModels, {}, {}, std::format("Block {} has no models", blockName));
+    }
+    else if (data.models.empty())
+    {
+        fail(BlockDiagnosticKind::NoModels, {}, {}, std::format("Block {} has no models", blockName));
+    }
+    else
+    {
+        for (const auto &[modelName, model] : data.models)
+        {
+            if (!model.wasLoaded)
+            {
+                fail(BlockDiagnosticKind::MissingModel, modelName, {},
+                     std::format("Missing model file for {}", modelName));
+                continue;
+            }
             try
             {
-                Validate(data.definition);
+                Validate(model);
             }
             catch (const std::exception &e)
             {
-                logger_.Error("Invalid BlockDefinition for " + blockName + ": " + e.what());
-                ok = false;
+                fail(BlockDiagnosticKind::InvalidModel, modelName, blockModelsFolder / (modelName.Str() + ".json"),
+                     std::format("Invalid BlockModel {} for block {}: {}", modelName, blockName, e.what()));
             }
         }
+    }
+
+    return ok;
+}
+
+BlockDiagnosticsReport BlockJsonDataCache::ValidateAllBlocks(const std::unordered_map<std::string, BlockJsonData> &blocks,
+                                                             std::vector<BlockDiagnostic> loadErrors) const
+{
+    const auto start = std::chrono::steady_clock::now();
 
-        // --- Models validation ---
-        if (data.models.empty())
+    std::vector<std::string> names;
+    for (auto type : AllBlockTypes())
+    {
+        std::string blockName = ToString(type);
+        if (blockName != "unknown" && blockName != "air")
+            names.push_back(std::move(blockName));
+    }
+    for (const BlockDiagnostic &error : loadErrors)
+        names.push_back(error.blockName);
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+
+    // Blocks are independent: shards only read the map and append to their own list.
+    BlockJsonLoader loader(logger_, config_);
+    std::vector<std::vector<BlockDiagnostic>> shardErrors(loader.ShardCount(names.size()));
+
+    loader.RunSharded(names.size(), [&](size_t shard, size_t index)
+    {
+        const std::string &blockName = names[index];
+        std::vector<BlockDiagnostic> &errors = shardErrors[shard];
+
+        auto it = blocks.find(blockName);
+        if (it == blocks.end())
         {
-            logger_.Error("Block " + blockName + " has no models");
-            ok = false;
+            errors.push_back({BlockDiagnosticKind::MissingBlock, blockName, {}, {},
+                              std::format("Missing BlockJsonData for: {}", blockName)});
+            return true;
         }
-        else
+
+        ValidateBlock(blockName, it->second, &errors);
+        return true;
+    });
+
+    BlockDiagnosticsReport report;
+    report.errors = std::move(loadErrors);
+    for (auto &errors : shardErrors)
+        std::move(errors.begin(), errors.end(), std::back_inserter(report.errors));
+
+    // Group by block; load errors of a block stay ahead of its validation errors.
+    std::stable_sort(report.errors.begin(), report.errors.end(),
+                     [](const BlockDiagnostic &a, const BlockDiagnostic &b) { return a.blockName < b.blockName; });
+
+    report.blocksChecked = names.size();
+    report.shards = shardErrors.size();
+    report.validateMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+BlockJsonData BlockJsonDataCache::Quarantine(const std::string &blockName, const BlockJsonData &broken)
+{
+    const Symbol missing(blockName + "_missing");
+    BlockJsonData data;
+
+    bool definitionOk = broken.definition.wasLoaded;
+    if (definitionOk)
+    {
+        try
+        {
+            Validate(broken.definition);
+        }
+        catch (const std::exception &)
+        {
+            definitionOk = false;
+        }
+    }
+    data.definition = definitionOk ? broken.definition : BlockDefinition{};
+    data.definition.wasLoaded = true;
+
+    data.state.properties = broken.state.properties;
+    data.state.variants.emplace(Symbol(""), missing);
+    data.state.wasLoaded = true;
+
+    DefaultTemplateModel cube;
+    cube.parent = "block/cube_all";
+    cube.textures.emplace(Symbol("all"), Symbol(MISSING_TEXTURE));
+
+    BlockModel model;
+    model.isBlockbench = false;
+    model.data = std::move(cube);
+    model.wasLoaded = true;
+    data.models.emplace(missing, std::move(model));
+
+    return data;
+}
+
+void BlockJsonDataCache::ValidateOrQuarantine(std::unordered_map<std::string, BlockJsonData> &blocks,
+                                              std::vector<BlockDiagnostic> loadErrors)
+{
+    diagnostics_ = ValidateAllBlocks(blocks, std::move(loadErrors));
+
+    LOG_INFO(logger_, LogCategory::Json, "Validated {} blocks on {} threads in {:.1f} ms",
+             diagnostics_.blocksChecked, diagnostics_.shards, diagnostics_.validateMs);
+
+    if (diagnostics_.Ok())
+        return;
+
+    // Every problem, unthrottled and in report order; parse errors were logged by the loader.
+    for (const BlockDiagnostic &error : diagnostics_.errors)
+    {
+        if (error.kind != BlockDiagnosticKind::ParseError)
+            LOG_ERROR(logger_, LogCategory::Json, "{}", error.message);
+    }
+
+    if (!config_.diagnosticsMode)
+        throw std::runtime_error("BlockJsonDataCache validation failed: missing or invalid data detected.");
+
+    for (const BlockDiagnostic &error : diagnostics_.errors)
+    {
+        if (diagnostics_.quarantined.empty() || diagnostics_.quarantined.back() != error.blockName)
+            diagnostics_.quarantined.push_back(error.blockName);
+    }
+
+    for (const std::string &blockName : diagnostics_.quarantined)
+    {
+        BlockJsonData &data = blocks[blockName];
+        BlockJsonData standIn = Quarantine(blockName, data);
+        pending_[blockName] = std::move(data); // a later fix builds on what was loaded
+        data = std::move(standIn);
+    }
+
+    LOG_WARNING(logger_, LogCategory::Json, "Quarantined {} blocks with {} problems behind the missing model",
+                diagnostics_.quarantined.size(), diagnostics_.errors.size());
+}
+
+void BlockJsonDataCache::Init()
+{
+    blockStatesFolder = paths_.GetPath(Folders::BlockStates);
+    blockModelsFolder = paths_.GetPath(Folders::BlockModels);
+    blockDefinitionsFolder = paths_.GetPath(Folders::BlockDefinitions);
+
+    if (config_.lazyModels)
+    {
+        // The bake holds every model, which is exactly what lazy mode avoids.
+        modelStore_ = std::make_unique<BlockModelStore>(logger_, blockModelsFolder, config_.modelCacheBytes, config_);
+    }
+
+    std::vector<BlockDiagnostic> loadErrors;
+    if (!config_.useBakedCache || config_.lazyModels)
+    {
+        auto blocks = LoadAllBlocks(loadErrors);
+        ValidateOrQuarantine(blocks, std::move(loadErrors));
+        Publish(std::move(blocks));
+        return;
+    }
+
+    const BlockJsonFolders folders{blockStatesFolder, blockDefinitionsFolder, blockModelsFolder};
+    const std::filesystem::path bakePath = config_.bakedCachePath.empty()
+                                               ? blockStatesFolder.parent_path() / "blocks.bake"
+                                               : config_.bakedCachePath;
+
+    BlockBakedCache baked(logger_);
+    std::unordered_map<std::string, BlockJsonData> blocks;
+    if (baked.TryLoad(bakePath, folders, blocks))
+    {
+        ValidateOrQuarantine(blocks, {});
+        Publish(std::move(blocks));
+        return;
+    }
+
+    // Manifest first: a file edited during the load must invalidate the new blob.
+    const auto manifest = BlockBakedCache::BuildManifest(folders);
+    blocks = LoadAllBlocks(loadErrors);
+    ValidateOrQuarantine(blocks, std::move(loadErrors));
+    if (diagnostics_.Ok())
+        baked.Save(bakePath, manifest, blocks); // stand-ins would hide the errors on the next start
+    Publish(std::move(blocks));
+}
+
+size_t BlockJsonDataCache::Reload(const std::vector<std::filesystem::path> &files)
+{
+    namespace fs = std::filesystem;
+    using FileKind = BlockJsonLoader::FileKind;
+
+    std::vector<BlockJsonChange> changes;
+    {
+        std::lock_guard<std::mutex> lock(reloadMutex_);
+
+        const Snapshot *current = snapshot_.load(std::memory_order_acquire);
+        BlockJsonLoader loader(logger_, config_);
+
+        // Per affected block: the staged data and what was applied to it.
+        struct Staged
+        {
+            BlockJsonChange change;
+            bool applied = false;
+            bool wasPending = false;
+        };
+        std::unordered_map<std::string, Staged> touched;
+
+        for (const fs::path &file : files)
         {
-            for (const auto &[modelName, model] : data.models)
+            if (file.extension() != ".json")
+                continue;
+
+            const fs::path folder = file.parent_path().lexically_normal();
+            FileKind kind;
+            if (folder == blockStatesFolder.lexically_normal())
+                kind = FileKind::State;
+            else if (folder == blockDefinitionsFolder.lexically_normal())
+                kind = FileKind::Definition;
+            else if (folder == blockModelsFolder.lexically_normal())
+                kind = FileKind::Model;
+            else
+                continue;
+
+            std::string stem = file.stem().string();
+            std::string blockName = stem;
+            if (kind == FileKind::Model)
             {
-                if (!model.wasLoaded)
-                {
-                    logger_.Error("Missing model file for " + modelName);
-                    ok = false;
+                auto underscorePos = stem.find('_');
+                if (underscorePos == std::string::npos)
                     continue;
+                blockName = stem.substr(0, underscorePos);
+            }
+
+            // Build on an earlier invalid edit if there is one, else on the published data.
+            auto [stagedIt, isNew] = touched.try_emplace(blockName);
+            Staged &staged = stagedIt->second;
+            if (isNew)
+            {
+                staged.change.blockName = blockName;
+                staged.wasPending = pending_.contains(blockName);
+                if (!staged.wasPending)
+                {
+                    auto it = current->blocks.find(blockName);
+                    pending_[blockName] = it != current->blocks.end() ? *it->second : BlockJsonData{};
                 }
+            }
+            BlockJsonData &data = pending_[blockName];
+
+            std::error_code ec;
+            if (kind == FileKind::Model && modelStore_)
+            {
+                // Only re-indexed here; the next AcquireModel() parses the new file.
+                modelStore_->OnFileChanged(file);
+            }
+            else if (!fs::exists(file, ec))
+            {
+                switch (kind)
+                {
+                case FileKind::State:
+                    data.state = {};
+                    break;
+                case FileKind::Definition:
+                    data.definition = {};
+                    break;
+                case FileKind::Model:
+                    data.models.erase(Symbol(stem));
+                    break;
+                }
+            }
+            else
+            {
                 try
                 {
-                    Validate(model);
+                    loader.LoadFile(kind, file, data, stem);
                 }
-                catch (const std::exception &e)
+                catch (const std::exception &)
                 {
-                    logger_.Error("Invalid BlockModel " + modelName + " for block " + blockName + ": " + e.what());
-                    ok = false;
+                    // Already logged by the loader; the block keeps its previous file.
+                    continue;
                 }
             }
+
+            staged.applied = true;
+            if (kind == FileKind::State)
+                staged.change.stateChanged = true;
+            else if (kind == FileKind::Definition)
+                staged.change.definitionChanged = true;
+            else
+                staged.change.changedModels.push_back(Symbol(stem));
+        }
+
+        std::unique_ptr<Snapshot> next;
+        for (auto &[blockName, staged] : touched)
+        {
+            if (!staged.applied)
+            {
+                // Nothing parsed: drop the copy unless it holds an earlier edit.
+                if (!staged.wasPending)
+                    pending_.erase(blockName);
+                continue;
+            }
+
+            BlockJsonData &data = pending_[blockName];
+            if (!ValidateBlock(blockName, data))
+            {
+                LOG_WARNING(logger_, LogCategory::Json,
+                            "Block {} is invalid after reload; keeping the previous version", blockName);
+                continue;
+            }
+
+            if (!next)
+                next = std::make_unique<Snapshot>(*current);
+
+            auto published = std::make_shared<const BlockJsonData>(std::move(data));
+            pending_.erase(blockName);
+
+            std::shared_ptr<const BlockJsonData> &slot = next->blocks[blockName];
+            staged.change.previous = std::move(slot);
+            staged.change.current = published;
+            slot = std::move(published);
+            changes.push_back(std::move(staged.change));
         }
 
-        if (!ok)
-            hasError = true;
+        if (next)
+            Store(std::move(next));
     }
 
-    if (hasError)
-        throw std::runtime_error("BlockJsonDataCache validation failed: missing or invalid data detected.");
+    if (!changes.empty())
+    {
+        LOG_INFO(logger_, LogCategory::Json, "Hot-reloaded {} blocks from {} files", changes.size(), files.size());
+        Notify(changes);
+    }
+
+    return changes.size();
 }
 
-void BlockJsonDataCache::Init()
+bool BlockJsonDataCache::EnableHotReload()
 {
-    blockStatesFolder = paths_.GetPath(Folders::BlockStates);
-    blockModelsFolder = paths_.GetPath(Folders::BlockModels);
-    blockDefinitionsFolder = paths_.GetPath(Folders::BlockDefinitions);
+    const bool started = watcher_.Start(
+        {blockStatesFolder, blockDefinitionsFolder, blockModelsFolder},
+        [this](const std::vector<FileWatcher::Change> &batch)
+        {
+            std::vector<std::filesystem::path> files;
+            files.reserve(batch.size());
+            for (const auto &change : batch)
+                files.push_back(change.path);
+            Reload(files);
+        });
+
+    if (started)
+        LOG_INFO(logger_, LogCategory::Json, "Watching block JSON folders for changes");
+    else
+        LOG_WARNING(logger_, LogCategory::Json, "Block JSON hot reload is not available");
+
+    return started;
+}
+
+void BlockJsonDataCache::DisableHotReload()
+{
+    watcher_.Stop();
+}
+
+size_t BlockJsonDataCache::Subscribe(ChangeCallback callback)
+{
+    std::lock_guard<std::mutex> lock(listenersMutex_);
+    const size_t id = nextListenerId_++;
+    listeners_.emplace_back(id, std::move(callback));
+    return id;
+}
+
+void BlockJsonDataCache::Unsubscribe(size_t id)
+{
+    std::lock_guard<std::mutex> lock(listenersMutex_);
+    std::erase_if(listeners_, [id](const auto &entry) { return entry.first == id; });
+}
 
-    LoadAllBlocks();
-    ValidateAllBlocks();
-}
\ No newline at end of file
+void BlockJsonDataCache::Notify(const std::vector<BlockJsonChange> &changes) const
+{
+    // Copy so that a callback may subscribe or unsubscribe.
+    std::vector<std::pair<size_t, ChangeCallback>> listeners;
+    {
+        std::lock_guard<std::mutex> lock(listenersMutex_);
+        listeners = listeners_;
+    }
+
+    for (const BlockJsonChange &change : changes)
+    {
+        for (const auto &[id, callback] : listeners)
+            callback(change);
+    }
+}
@@ -6,111 +6,39 @@
 #include <filesystem>
 #include <sstream>
 #include <format>
-
-#include "BlockModelConfig.h"
-#include "BlockStateConfig.h"
-#include "BlockDefinitionConfig.h"
-#include "Options.h"
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "BlockJsonData.h"
+#include "BlockHotData.h"
+#include "BlockJsonLoader.h"
+#include "BlockBakedCache.h"
+#include "BlockModelStore.h"
+#include "LogMacros.h"
 #include "BlockTypes.h"
 
 #include "IPathProvider.h"
 #include "ILogger.h"
-
-#include "IDebugPrintable.h"
-#include "DebugColors.h"
+#include "FileWatcher.h"
 
 /**
- * @brief Holds all JSON-parsed data related to a single block type.
- *
- * This structure aggregates all information about a block loaded from
- * its configuration JSON files, including its state, definition, and
- * associated models.
+ * @brief Describes one block republished by a hot reload.
  *
- * @struct BlockJsonData
- * @see BlockState
- * @see BlockDefinition
- * @see BlockModel
+ * Sent to subscribers so that dependent meshes and atlases can rebuild only
+ * what changed.
  */
-struct BlockJsonData : public IDebugPrintable
+struct BlockJsonChange
 {
-    /** @brief Describes the possible or current states of the block. */
-    BlockState state;
-
-    /** @brief Defines physical and visual properties of the block. */
-    BlockDefinition definition;
-
-    /**
-     * @brief Maps model names to their corresponding block models.
-     *
-     * A single block may have multiple models representing different
-     * orientations, variants, or states.
-     *
-     * Each model name must start with the block name followed by an underscore.
-     * Example: `log_waterfilled`.
-     */
-    std::unordered_map<std::string, BlockModel> models;
-
-    /// @copydoc IDebugPrintable::ToShortString
-    std::string ToShortString() const override
-    {
-        return std::format("BlockJsonData(models={}, state={}, def={})",
-                           models.size(),
-                           state.ToShortString(),
-                           definition.ToShortString());
-    }
-
-    /// @copydoc IDebugPrintable::ToPrettyString
-    std::string ToPrettyString() const override
-    {
-        using namespace DebugHelpers;
-        using namespace DebugColors;
-
-        std::ostringstream ss;
-        ss << Bold << "BlockJsonData" << Reset << " " << Dim << "{\n"
-           << Reset;
-
-        // --- Definition ---
-        ss << "  " << BrightMagenta << "Definition:" << Reset << "\n";
-        {
-            std::string defStr = definition.ToPrettyString();
-            std::istringstream defStream(defStr);
-            std::string line;
-            while (std::getline(defStream, line))
-                ss << "    " << line << '\n';
-        }
-
-        // --- State ---
-        ss << "  " << BrightMagenta << "State:" << Reset << "\n";
-        {
-            std::string stateStr = state.ToPrettyString();
-            std::istringstream stateStream(stateStr);
-            std::string line;
-            while (std::getline(stateStream, line))
-                ss << "    " << line << '\n';
-        }
-
-        // --- Models ---
-        ss << "  " << BrightMagenta << "Models:" << Reset << "\n";
-        if (models.empty())
-        {
-            ss << "    (none)\n";
-        }
-        else
-        {
-            for (const auto &[key, model] : models)
-            {
-                ss << std::format("    [{}{}{}]:\n", Magenta, key, Reset);
-                std::string modelStr = model.ToPrettyString();
-                std::istringstream modelStream(modelStr);
-                std::string line;
-                while (std::getline(modelStream, line))
-                    ss << "      " << line << '\n';
-            }
-        }
-
-        ss << Dim << "}" << Reset;
-        return ss.str();
-    }
+    std::string blockName;                          ///< Block whose data was replaced.
+    std::shared_ptr<const BlockJsonData> previous;  ///< Old data; @c nullptr for a new block.
+    std::shared_ptr<const BlockJsonData> current;   ///< Newly published data.
+    bool stateChanged = false;                      ///< The block state file was reloaded.
+    bool definitionChanged = false;                 ///< The block definition file was reloaded.
+    std::vector<Symbol> changedModels;              ///< Models reloaded, added or removed.
 };
 
 /**
@@ -120,6 +48,21 @@ struct BlockJsonData : public IDebugPrintable
  * to avoid redundant file reads during runtime. It is typically initialized once
  * during startup and then used as a read-only resource.
  *
+ * With @ref EnableHotReload() the JSON folders are watched and only the
+ * changed files are parsed again. Each reloaded block is validated on its own
+ * and published by swapping an immutable snapshot, so readers never wait for
+ * a reload. Data returned by @ref Get() stays valid for the lifetime of the
+ * cache: replaced versions are retired, not freed.
+ *
+ * With @c lazyModels set in the config, models are not part of
+ * @ref BlockJsonData; they are parsed on first use by a
+ * @ref BlockModelStore. @ref AcquireModel() and @ref GetModelNames() work in
+ * both modes, so renderers should prefer them over @c BlockJsonData::models.
+ *
+ * Validation of the initial load runs in parallel. By default any problem
+ * stops startup; with @c diagnosticsMode set, broken blocks are quarantined
+ * behind a fallback "missing" model and listed in @ref GetDiagnostics().
+ *
  * @note Intended for global use through @ref Instance().
  *
  * @see BlockJsonData
@@ -129,14 +72,86 @@ struct BlockJsonData : public IDebugPrintable
  */
 class BlockJsonDataCache
 {
+public:
+    /** @brief Receives one republished block, on the reloading thread. */
+    using ChangeCallback = std::function<void(const BlockJsonChange &)>;
+
 private:
+    /** @brief Immutable view of all blocks; replaced as a whole on reload. */
+    struct Snapshot
+    {
+        /** @brief Block data keyed by block name (e.g., `"minecraft:stone"`). */
+        std::unordered_map<std::string, std::shared_ptr<const BlockJsonData>> blocks;
+
+        /** @brief Numeric id of every block name seen so far. */
+        std::unordered_map<std::string, BlockId> ids;
+
+        /** @brief Hot records indexed by @ref BlockId; @c data is @c nullptr for missing blocks. */
+        std::vector<BlockHotData> dense;
+
+        /** @brief Block names indexed by @ref BlockId; views into @c names_. */
+        std::vector<std::string_view> names;
+    };
+
+    /**
+     * @brief Current snapshot.
+     *
+     * Readers load the pointer without locking; reloads store a new one.
+     */
+    std::atomic<const Snapshot *> snapshot_{nullptr};
+
+    /** @brief Owns the current snapshot. */
+    std::unique_ptr<Snapshot> current_;
+
+    /**
+     * @brief Every replaced snapshot, oldest first.
+     *
+     * The objects are never freed while the cache lives: a reader may still
+     * hold the pointer, and the hot records handed out by @ref GetHot() live
+     * in their @c dense tables. Only their maps are freed, see @ref ReleaseRetired().
+     */
+    std::vector<std::unique_ptr<Snapshot>> retired_;
+
+    /** @brief Number of leading @c retired_ entries whose maps are already freed. */
+    size_t released_ = 0;
+
+    /** @brief Block versions referenced by freed maps that no later snapshot holds. */
+    std::vector<std::shared_ptr<const BlockJsonData>> replaced_;
+
     /**
-     * @brief Maps block identifiers to their corresponding JSON-parsed data.
+     * @brief Number of getters reading the maps of a snapshot.
      *
-     * The key is the block name (e.g., `"minecraft:stone"`),
-     * and the value contains its state, definition, and models.
+     * Retired maps are only freed by a reload that sees it at zero. The dense
+     * table and names are never freed or moved, so their readers skip it.
      */
-    std::unordered_map<std::string, BlockJsonData> cache_;
+    mutable std::atomic<uint32_t> mapReaders_{0};
+
+    /** @brief Every block name ever assigned an id; only appended, so views stay valid. */
+    std::deque<std::string> names_;
+
+    /** @brief Serializes reloads and guards @c pending_ and the snapshot storage. */
+    std::mutex reloadMutex_;
+
+    /**
+     * @brief Edited blocks that failed validation.
+     *
+     * Later edits to the same block build on these, so fixing one file of a
+     * multi-file change publishes the block once all files are valid again.
+     * Quarantined blocks start here with the data they were loaded with.
+     */
+    std::unordered_map<std::string, BlockJsonData> pending_;
+
+    /** @brief Guards @c listeners_. */
+    mutable std::mutex listenersMutex_;
+
+    /** @brief Change subscribers with their ids. */
+    std::vector<std::pair<size_t, ChangeCallback>> listeners_;
+
+    /** @brief Id handed out by the next @ref Subscribe() call. */
+    size_t nextListenerId_ = 1;
+
+    /** @brief Watches the JSON folders while hot reload is enabled. */
+    FileWatcher watcher_;
 
     /** @brief Path to the folder containing block state JSON files. */
     std::filesystem::path blockStatesFolder;
@@ -153,105 +168,121 @@ private:
     /** @brief Reference to the path provider used to resolve resource directories. */
     const IPathProvider &paths_;
 
+    /** @brief Loading options (parallelism). */
+    BlockJsonDataCacheConfig config_;
+
+    /** @brief On-demand models; @c nullptr unless @c config_.lazyModels is set. */
+    std::unique_ptr<BlockModelStore> modelStore_;
+
+    /** @brief Problems found by the initial load; written once in @c Init(). */
+    BlockDiagnosticsReport diagnostics_;
+
 private:
     /**
-     * @brief Loads and parses a JSON file into an object of the specified type.
-     *
-     * @tparam T The type representing the JSON structure.
-     * @param path Path to the JSON file.
-     * @return A fully initialized object of type @c T with @c wasLoaded set to @c true.
+     * @brief Validates one block's state, definition and models.
      *
-     * @throws std::runtime_error If the file cannot be opened or parsed.
+     * Calls @c Validate() on each JSON structure and reports every problem
+     * through @ref ILogger. With lazy models only the presence of model
+     * files is checked; each model is validated when it is first loaded.
      *
-     * @note The function assumes that @c Options<T> performs JSON parsing
-     *       and that type @c T contains a boolean field @c wasLoaded.
+     * @param errors Receives every problem as well, if not @c nullptr.
+     * @return @c true if the block is complete and valid.
      */
-    template <typename T>
-    T LoadJsonFile(const std::filesystem::path &path)
-    {
-        try
-        {
-            Options<T> opts(path.string());
-            T obj = opts.Value();
-            obj.wasLoaded = true;
-            return obj;
-        }
-        catch (const std::exception &e)
-        {
-            logger_.Error("Failed to load JSON: " + path.string() + " (" + e.what() + ")");
-            throw;
-        }
-    }
+    bool ValidateBlock(const std::string &blockName, const BlockJsonData &data,
+                       std::vector<BlockDiagnostic> *errors = nullptr) const;
 
     /**
-     * @brief Loads all block state configurations from the @c blockStatesFolder.
+     * @brief Validates all loaded block configurations in parallel.
      *
-     * Iterates over all `.json` files and loads each into the cache.
-     * The file name (without extension) is used as the block identifier.
+     * Checks that each registered block (except "unknown" and "air") is
+     * present in @p blocks and passes @ref ValidateBlock(), as well as every
+     * block named in @p loadErrors. Logs nothing and never throws.
      *
-     * @throws std::filesystem::filesystem_error If the directory cannot be accessed.
-     * @throws std::runtime_error If any JSON file cannot be parsed.
+     * @param loadErrors Files the loader skipped; copied to the front of the report.
+     * @return All problems, grouped by block; @c quarantined is left empty.
      */
-    void LoadAllStates();
+    BlockDiagnosticsReport ValidateAllBlocks(const std::unordered_map<std::string, BlockJsonData> &blocks,
+                                             std::vector<BlockDiagnostic> loadErrors) const;
 
     /**
-     * @brief Loads all block definition configurations from the @c blockDefinitionsFolder.
+     * @brief Validates @p blocks and stores the report in @c diagnostics_.
      *
-     * Each file name (without extension) is used as the block identifier.
+     * In diagnostics mode every block with a problem is replaced by its
+     * quarantined version (fallback "missing" model, see @ref Quarantine())
+     * and its loaded data is kept in @c pending_ for hot reload.
      *
-     * @throws std::filesystem::filesystem_error If the directory cannot be accessed.
-     * @throws std::runtime_error If any JSON file cannot be parsed.
+     * @throws std::runtime_error If any block is broken and diagnostics mode is off.
      */
-    void LoadAllDefinitions();
+    void ValidateOrQuarantine(std::unordered_map<std::string, BlockJsonData> &blocks,
+                              std::vector<BlockDiagnostic> loadErrors);
 
     /**
-     * @brief Loads all block models from the @c blockModelsFolder.
-     *
-     * Expects model filenames to follow the pattern: `blockName_modelName.json`.
-     * The part before the first underscore is treated as the block name.
+     * @brief Builds the stand-in for broken block @p blockName.
      *
-     * @throws std::filesystem::filesystem_error If the directory cannot be accessed.
-     * @throws std::runtime_error If any JSON file cannot be parsed.
-     *
-     * @note Files without an underscore ('_') are ignored.
+     * The stand-in has one variant pointing to a `<blockName>_missing` cube
+     * model. The definition and state properties of @p broken are kept when
+     * they are valid, so the block keeps its shape and state ids.
      */
-    void LoadAllModels();
+    static BlockJsonData Quarantine(const std::string &blockName, const BlockJsonData &broken);
 
     /**
-     * @brief Validates all loaded block configurations.
-     *
-     * Ensures that each registered block (except "unknown" and "air")
-     * has valid and fully loaded data for its state, definition, and models.
+     * @brief Loads all block-related JSON data.
      *
-     * Validation steps:
-     * - Confirms presence of each component.
-     * - Calls @c Validate() on each JSON structure.
-     * - Reports all errors through @ref ILogger.
+     * Block states, definitions and models are parsed by @ref BlockJsonLoader,
+     * in parallel on @ref ThreadPool unless disabled in @c config_.
      *
-     * @throws std::runtime_error If any block has missing or invalid data.
+     * @param loadErrors Receives the files skipped in diagnostics mode.
      *
-     * @note Validation continues through all blocks before throwing an error.
+     * @throws std::filesystem::filesystem_error If directories are inaccessible.
+     * @throws std::runtime_error If a JSON file cannot be parsed, unless in diagnostics mode.
      */
-    void ValidateAllBlocks() const;
+    std::unordered_map<std::string, BlockJsonData> LoadAllBlocks(std::vector<BlockDiagnostic> &loadErrors);
+
+    /** @brief Publishes @p blocks as the first snapshot. */
+    void Publish(std::unordered_map<std::string, BlockJsonData> &&blocks);
 
     /**
-     * @brief Loads all block-related JSON data.
+     * @brief Assigns ids to new block names and rebuilds @c dense of @p snapshot.
      *
-     * Sequentially loads:
-     * - Block states
-     * - Block definitions
-     * - Block models
+     * Existing ids are kept; new names are numbered in sorted order.
+     */
+    void BuildDenseTable(Snapshot &snapshot);
+
+    /** @brief Makes @p snapshot current; caller holds @c reloadMutex_ or is in @c Init(). */
+    void Store(std::unique_ptr<Snapshot> snapshot);
+
+    /**
+     * @brief Frees the maps of retired snapshots if no getter is reading them.
      *
-     * @throws std::filesystem::filesystem_error If directories are inaccessible.
-     * @throws std::runtime_error If a JSON file cannot be parsed.
+     * Otherwise they are freed by a later reload. The dense tables and names
+     * are kept in place.
      */
-    void LoadAllBlocks();
+    void ReleaseRetired();
+
+    /** @brief Calls @p fn with the current snapshot while its maps are protected from @ref ReleaseRetired(). */
+    template <typename Fn>
+    auto ReadMaps(Fn &&fn) const noexcept
+    {
+        // seq_cst pairs with Store(): either the reload sees this reader, or
+        // the reader sees the new snapshot.
+        mapReaders_.fetch_add(1, std::memory_order_seq_cst);
+        auto result = fn(*snapshot_.load(std::memory_order_seq_cst));
+        mapReaders_.fetch_sub(1, std::memory_order_release);
+        return result;
+    }
+
+    /** @brief Sends @p changes to every subscriber. */
+    void Notify(const std::vector<BlockJsonChange> &changes) const;
 
     /**
      * @brief Initializes the cache by loading and validating all data.
      *
-     * Obtains resource directories from @c IPathProvider,
-     * loads all block JSON files, and performs validation.
+     * Obtains resource directories from @c IPathProvider, then either maps
+     * the baked binary cache (when the JSON files are unchanged) or loads
+     * all block JSON files and re-bakes them once they pass validation.
+     * With lazy models the bake is skipped and only the model folder is
+     * indexed. A load with quarantined blocks is not baked, so the next
+     * start reports them again.
      * This method runs automatically during construction.
      *
      * @throws std::filesystem::filesystem_error If directories cannot be accessed.
@@ -266,10 +297,11 @@ private:
      *
      * @param logger Reference to an @c ILogger instance for reporting messages and errors.
      * @param paths  Reference to an @c IPathProvider for resolving resource paths.
+     * @param config Loading options.
      *
      * @throws std::runtime_error If initialization or validation fails.
      */
-    BlockJsonDataCache(ILogger &logger, const IPathProvider &paths);
+    BlockJsonDataCache(ILogger &logger, const IPathProvider &paths, const BlockJsonDataCacheConfig &config);
 
 public:
     BlockJsonDataCache(const BlockJsonDataCache &) = delete;
@@ -277,6 +309,9 @@ public:
     BlockJsonDataCache(BlockJsonDataCache &&) = delete;
     BlockJsonDataCache &operator=(BlockJsonDataCache &&) = delete;
 
+    /** @brief Stops the hot-reload watcher, if running. */
+    ~BlockJsonDataCache();
+
     /**
      * @brief Returns the global singleton instance of the cache.
      *
@@ -284,9 +319,11 @@ public:
      *
      * @param logger Reference to a logger used for reporting messages.
      * @param paths  Reference to a path provider used to resolve directories.
+     * @param config Loading options; only used by the first call.
      * @return Reference to the global @c BlockJsonDataCache instance.
      */
-    static BlockJsonDataCache &Instance(ILogger &logger, const IPathProvider &paths);
+    static BlockJsonDataCache &Instance(ILogger &logger, const IPathProvider &paths,
+                                        const BlockJsonDataCacheConfig &config = {});
 
     /**
      * @brief Retrieves block data by block name.
@@ -302,7 +339,7 @@ public:
     /**
      * @brief Retrieves block data by @c BlockType.
      *
-     * Converts @p type to its string representation and calls @ref Get(const std::string&).
+     * Reads the dense table, like @ref GetHot(BlockType).
      *
      * @param type The block type.
      * @return Optional constant reference to the cached block data,
@@ -312,6 +349,127 @@ public:
     std::optional<std::reference_wrapper<const BlockJsonData>>
     Get(BlockType type) const;
 
+    /**
+     * @brief Returns the hot record of a block by @c BlockType.
+     *
+     * O(1) and allocation-free; intended for per-block and per-face queries.
+     * The pointer stays valid for the lifetime of the cache, but a reload
+     * publishes a new record, so re-query instead of caching it across frames.
+     *
+     * @return The record, or @c nullptr if the block has no data (e.g. air).
+     */
+    [[nodiscard]]
+    const BlockHotData *GetHot(BlockType type) const noexcept;
+
+    /**
+     * @brief Returns the hot record of a block by runtime numeric id.
+     *
+     * @return The record, or @c nullptr if @p id is unknown or has no data.
+     */
+    [[nodiscard]]
+    const BlockHotData *GetHot(BlockId id) const noexcept;
+
+    /**
+     * @brief Returns one past the highest assigned @ref BlockId.
+     *
+     * Iterate `0 .. GetIdCount()` with @ref GetHot(BlockId) to visit every block.
+     */
+    [[nodiscard]]
+    size_t GetIdCount() const noexcept;
+
+    /**
+     * @brief Returns the name of block @p id, or an empty view if unknown.
+     *
+     * The view stays valid for the lifetime of the cache.
+     */
+    [[nodiscard]]
+    std::string_view GetName(BlockId id) const noexcept;
+
+    /**
+     * @brief Resolves a block name to its numeric id.
+     *
+     * Meant for tooling and load-time lookups; hot paths should keep the id.
+     */
+    [[nodiscard]]
+    std::optional<BlockId> GetId(const std::string &name) const;
+
+    /**
+     * @brief Retrieves the current version of a block as a shared pointer.
+     *
+     * Unlike @ref Get(), the caller can compare it with later versions.
+     *
+     * @return The block data, or @c nullptr if not found.
+     */
+    [[nodiscard]]
+    std::shared_ptr<const BlockJsonData> GetShared(const std::string &name) const;
+
+    /**
+     * @brief Pins model @p name, loading it first in lazy mode.
+     *
+     * In eager mode the handle shares ownership of the block's current data
+     * and nothing is evicted.
+     *
+     * @return The model, or an empty handle if it is unknown or failed to load.
+     */
+    [[nodiscard]]
+    BlockModelHandle AcquireModel(Symbol name) const;
+
+    /** @brief Names of the models of block @p blockName, sorted by text. */
+    [[nodiscard]]
+    std::vector<Symbol> GetModelNames(const std::string &blockName) const;
+
+    /** @brief Counters of the on-demand model store; all zero in eager mode. */
+    [[nodiscard]]
+    BlockModelStore::Stats GetModelStats() const;
+
+    /**
+     * @brief Problems found by the initial load and the blocks quarantined for them.
+     *
+     * Empty unless something was broken. Without @c diagnosticsMode a
+     * non-empty report means construction threw, so this is mainly useful in
+     * diagnostics mode.
+     */
+    [[nodiscard]]
+    const BlockDiagnosticsReport &GetDiagnostics() const noexcept { return diagnostics_; }
+
+    /**
+     * @brief Re-parses the given block JSON files and republishes their blocks.
+     *
+     * Each path must lie in the states, definitions or models folder; other
+     * paths are ignored. A path that no longer exists removes that part of
+     * the block. Every affected block is validated on its own: a valid block
+     * replaces the old version in a new snapshot, an invalid one keeps the
+     * old version and waits for the next edit. Parse errors never throw.
+     *
+     * @param files Changed files.
+     * @return Number of blocks republished.
+     */
+    size_t Reload(const std::vector<std::filesystem::path> &files);
+
+    /**
+     * @brief Starts watching the block JSON folders and reloading changed files.
+     *
+     * Reloads run on the watcher thread.
+     *
+     * @return @c false if file watching is unsupported on this platform.
+     */
+    bool EnableHotReload();
+
+    /** @brief Stops watching the block JSON folders. */
+    void DisableHotReload();
+
+    /**
+     * @brief Registers @p callback for every block republished by a reload.
+     *
+     * Called outside the reload lock, once per block.
+     *
+     * @return Id for @ref Unsubscribe().
+     */
+    size_t Subscribe(ChangeCallback callback);
+
+    /** @brief Removes a callback registered with @ref Subscribe(). */
+    void Unsubscribe(size_t id);
+
     /**
      * @brief Returns the total number of cached block entries.
      *
@@ -0,0 +1,322 @@
+#include "BlockJsonLoader.h"
+#include "Options.h"
+#include "LogMacros.h"
+#include "ThreadPool.h"
+#include "TaskFactory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <format>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedMs(Clock::time_point from, Clock::time_point to)
+    {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+
+    /**
+     * @brief Partial result of one shard.
+     *
+     * Only the owning shard writes to it until the join, so parsing never locks.
+     */
+    struct Shard
+    {
+        std::unordered_map<std::string, BlockJsonData> blocks;
+        std::exception_ptr error;
+        size_t errorJob = std::numeric_limits<size_t>::max();
+        std::vector<std::pair<size_t, BlockDiagnostic>> skipped; ///< Job index and error, diagnostics mode only.
+    };
+}
+
+BlockJsonLoader::BlockJsonLoader(ILogger &logger, const BlockJsonDataCacheConfig &config)
+    : logger_(logger), config_(config)
+{
+}
+
+template <typename T>
+T BlockJsonLoader::LoadJsonFile(const std::filesystem::path &path)
+{
+    try
+    {
+        Options<T> opts(path.string());
+        T obj = opts.Value();
+        obj.wasLoaded = true;
+        return obj;
+    }
+    catch (const std::exception &e)
+    {
+        LOG_ERROR(logger_, LogCategory::Json, "Failed to load JSON: {} ({})", path.string(), e.what());
+        throw;
+    }
+}
+
+std::vector<BlockJsonLoader::Job> BlockJsonLoader::Enumerate(const std::filesystem::path &statesFolder,
+                                                             const std::filesystem::path &definitionsFolder,
+                                                             const std::filesystem::path &modelsFolder)
+{
+    namespace fs = std::filesystem;
+    std::vector<Job> jobs;
+
+    auto scan = [&](const fs::path &folder, FileKind kind)
+    {
+        for (const auto &entry : fs::directory_iterator(folder))
+        {
+            if (!entry.is_regular_file() || entry.path().extension() != ".json")
+                continue;
+
+            std::string stem = entry.path().stem().string();
+            if (kind != FileKind::Model)
+            {
+                jobs.push_back({kind, entry.path(), std::move(stem), {}});
+                continue;
+            }
+
+            auto underscorePos = stem.find('_');
+            if (underscorePos == std::string::npos)
+                continue;
+
+            std::string blockName = stem.substr(0, underscorePos);
+            jobs.push_back({kind, entry.path(), std::move(blockName), std::move(stem)});
+        }
+    };
+
+    scan(statesFolder, FileKind::State);
+    scan(definitionsFolder, FileKind::Definition);
+    scan(modelsFolder, FileKind::Model);
+    return jobs;
+}
+
+void BlockJsonLoader::LoadFile(FileKind kind, const std::filesystem::path &path, BlockJsonData &data,
+                               const std::string &modelName)
+{
+    switch (kind)
+    {
+    case FileKind::State:
+        data.state = LoadJsonFile<BlockState>(path);
+        break;
+    case FileKind::Definition:
+        data.definition = LoadJsonFile<BlockDefinition>(path);
+        break;
+    case FileKind::Model:
+        data.models[Symbol(modelName)] = LoadJsonFile<BlockModel>(path);
+        break;
+    }
+}
+
+BlockModel BlockJsonLoader::LoadModel(const std::filesystem::path &path)
+{
+    return LoadJsonFile<BlockModel>(path);
+}
+
+void BlockJsonLoader::RunJob(const Job &job, std::unordered_map<std::string, BlockJsonData> &partial)
+{
+    LoadFile(job.kind, job.path, partial[job.blockName], job.modelName);
+}
+
+ThreadPool *BlockJsonLoader::Pool() const
+{
+    if (config_.pool)
+        return config_.pool;
+
+    return config_.parallel ? &ThreadPool::Instance() : nullptr;
+}
+
+size_t BlockJsonLoader::ShardCount(size_t count) const
+{
+    ThreadPool *pool = Pool();
+    if (!config_.parallel || !pool || count < 2)
+        return 1;
+
+    const size_t workers = pool->GetWorkers().size();
+    if (workers == 0)
+        return 1;
+
+    size_t shards = workers + 1; // the calling thread works too
+    if (config_.maxParallelism > 0)
+        shards = std::min(shards, config_.maxParallelism);
+
+    return std::clamp<size_t>(shards, 1, count);
+}
+
+void BlockJsonLoader::RunSharded(size_t count, const std::function<bool(size_t shard, size_t index)> &work) const
+{
+    const size_t shardCount = ShardCount(count);
+
+    // Shared with the pool tasks: a shard task may start after this call returned
+    // (or never, e.g. from a busy pool worker or during shutdown), so it must
+    // not rely on this frame and the caller must not wait for it.
+    struct State
+    {
+        std::atomic<size_t> nextIndex{0};
+        std::atomic<bool> stopped{false};
+        std::mutex mutex;
+        std::condition_variable doneCv;
+        size_t running = 0; // shards that started and have not finished
+        bool closed = false; // set once the calling thread ran out of items
+    };
+    const auto state = std::make_shared<State>();
+
+    auto runShard = [state, count, &work](size_t shard)
+    {
+        while (!state->stopped.load(std::memory_order_relaxed))
+        {
+            const size_t index = state->nextIndex.fetch_add(1, std::memory_order_relaxed);
+            if (index >= count)
+                break;
+
+            if (!work(shard, index))
+                state->stopped.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    // Shards 1..N-1 go to the pool; a shard that is rejected or starts too late
+    // does nothing, the others pick up its items through the shared counter.
+    for (size_t i = 1; i < shardCount; ++i)
+    {
+        auto task = TaskFactory::MakeTask([state, runShard, i]()
+        {
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (state->closed)
+                    return;
+                ++state->running;
+            }
+
+            runShard(i);
+
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (--state->running == 0)
+                state->doneCv.notify_one();
+        });
+
+        try
+        {
+            (void)Pool()->AddTask(config_.taskType, std::move(task));
+        }
+        catch (const std::exception &)
+        {
+            // The dispatch strategy refused the task; treat it like a full queue.
+        }
+    }
+
+    // The calling thread works until no item is left, so it never depends on a
+    // queued shard being scheduled; then it only waits for shards already running.
+    runShard(0);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->closed = true;
+    state->doneCv.wait(lock, [&] { return state->running == 0; });
+}
+
+std::unordered_map<std::string, BlockJsonData>
+BlockJsonLoader::LoadAll(const std::filesystem::path &statesFolder,
+                         const std::filesystem::path &definitionsFolder,
+                         const std::filesystem::path &modelsFolder)
+{
+    stats_ = {};
+    errors_.clear();
+    const auto start = Clock::now();
+
+    std::vector<Job> jobs = Enumerate(statesFolder, definitionsFolder, modelsFolder);
+    if (config_.lazyModels)
+        std::erase_if(jobs, [](const Job &job) { return job.kind == FileKind::Model; });
+    const auto scanned = Clock::now();
+
+    const size_t shardCount = ShardCount(jobs.size());
+    std::vector<Shard> shards(shardCount);
+
+    RunSharded(jobs.size(), [&](size_t shardIndex, size_t index)
+    {
+        Shard &shard = shards[shardIndex];
+        try
+        {
+            RunJob(jobs[index], shard.blocks);
+        }
+        catch (const std::exception &e)
+        {
+            if (!config_.diagnosticsMode)
+            {
+                shard.error = std::current_exception();
+                shard.errorJob = index;
+                return false;
+            }
+
+            // Already logged by LoadJsonFile(); the block is missing this file now.
+            const Job &job = jobs[index];
+            shard.skipped.emplace_back(index, BlockDiagnostic{
+                BlockDiagnosticKind::ParseError, job.blockName,
+                job.kind == FileKind::Model ? Symbol(job.modelName) : Symbol{}, job.path,
+                std::format("Failed to load JSON: {} ({})", job.path.string(), e.what())});
+        }
+        catch (...)
+        {
+            shard.error = std::current_exception();
+            shard.errorJob = index;
+            return false;
+        }
+        return true;
+    });
+    const auto parsed = Clock::now();
+
+    // Same contract as the sequential loader: report the earliest failing file.
+    const Shard *firstError = nullptr;
+    for (const Shard &shard : shards)
+    {
+        if (shard.error && (!firstError || shard.errorJob < firstError->errorJob))
+            firstError = &shard;
+    }
+    if (firstError)
+        std::rethrow_exception(firstError->error);
+
+    std::vector<std::pair<size_t, BlockDiagnostic>> skipped;
+    for (Shard &shard : shards)
+        std::move(shard.skipped.begin(), shard.skipped.end(), std::back_inserter(skipped));
+    std::sort(skipped.begin(), skipped.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+    for (auto &[index, diagnostic] : skipped)
+        errors_.push_back(std::move(diagnostic));
+
+    std::unordered_map<std::string, BlockJsonData> result;
+    result.reserve(shards[0].blocks.size() * shardCount);
+
+    for (Shard &shard : shards)
+    {
+        for (auto &[name, partial] : shard.blocks)
+        {
+            BlockJsonData &data = result[name];
+            if (partial.state.wasLoaded)
+                data.state = std::move(partial.state);
+            if (partial.definition.wasLoaded)
+                data.definition = std::move(partial.definition);
+            for (auto &[modelName, model] : partial.models)
+                data.models[modelName] = std::move(model);
+        }
+    }
+    const auto merged = Clock::now();
+
+    stats_.files = jobs.size();
+    stats_.blocks = result.size();
+    stats_.shards = shardCount;
+    stats_.scanMs = ElapsedMs(start, scanned);
+    stats_.parseMs = ElapsedMs(scanned, parsed);
+    stats_.mergeMs = ElapsedMs(parsed, merged);
+
+    if (!errors_.empty())
+        LOG_WARNING(logger_, LogCategory::Json, "Skipped {} block files that failed to load", errors_.size());
+
+    LOG_INFO(logger_, LogCategory::Json,
+             "Parsed {} block files into {} blocks on {} threads in {:.1f} ms (scan {:.1f}, parse {:.1f}, merge {:.1f})",
+             stats_.files, stats_.blocks, stats_.shards,
+             ElapsedMs(start, merged), stats_.scanMs, stats_.parseMs, stats_.mergeMs);
+
+    return result;
+}
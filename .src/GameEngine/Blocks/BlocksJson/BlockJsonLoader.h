@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BlockJsonData.h"
+#include "BlockDiagnostics.h"
+#include "TaskType.h"
+#include "ILogger.h"
+
+class ThreadPool;
+
+/**
+ * @brief Options for loading block JSON files.
+ *
+ * Passed to @ref BlockJsonDataCache::Instance() on first use.
+ */
+struct BlockJsonDataCacheConfig
+{
+    /**
+     * @brief Parse files as @ref ThreadPool tasks.
+     *
+     * Falls back to the calling thread when disabled or when the pool has
+     * no workers (ThreadPool::Init() was not called).
+     */
+    bool parallel = true;
+
+    /**
+     * @brief Upper bound on loader shards, the calling thread included.
+     *
+     * 0 means one shard per pool worker plus the calling thread.
+     */
+    size_t maxParallelism = 0;
+
+    /** @brief Task category used for loader shards. */
+    TaskType taskType = TaskType::Heavy;
+
+    /** @brief Pool to run on; @c nullptr means ThreadPool::Instance(). */
+    ThreadPool *pool = nullptr;
+
+    /**
+     * @brief Start from the baked binary copy when the JSON files are unchanged
+     *        (see @ref BlockBakedCache), and re-bake after a JSON load.
+     */
+    bool useBakedCache = true;
+
+    /** @brief Location of the baked copy; empty means `blocks.bake` next to the block folders. */
+    std::filesystem::path bakedCachePath;
+
+    /**
+     * @brief Parse models on first use instead of at startup.
+     *
+     * States and definitions still load eagerly; models are loaded by
+     * @ref BlockModelStore and reached through
+     * @ref BlockJsonDataCache::AcquireModel(). @c BlockJsonData::models stays
+     * empty and the baked cache is not used.
+     */
+    bool lazyModels = false;
+
+    /** @brief Resident size of lazily loaded models above which unpinned ones are evicted. */
+    size_t modelCacheBytes = 64 * 1024 * 1024;
+
+    /**
+     * @brief Keep running when some blocks are broken.
+     *
+     * Files that fail to parse are skipped instead of aborting the load, and
+     * blocks that fail validation are quarantined: they get the fallback
+     * "missing" model instead of stopping startup. Every problem is collected
+     * in @ref BlockJsonDataCache::GetDiagnostics(). Off by default, so that
+     * a broken pack still fails loudly during development.
+     */
+    bool diagnosticsMode = false;
+};
+
+/**
+ * @brief Timing of the last @ref BlockJsonLoader::LoadAll() call.
+ */
+struct BlockJsonLoadStats
+{
+    size_t files = 0;   ///< Number of JSON files parsed.
+    size_t blocks = 0;  ///< Number of block entries after the merge.
+    size_t shards = 0;  ///< Number of shards that took part, the calling thread included.
+    double scanMs = 0;  ///< Time spent enumerating the folders.
+    double parseMs = 0; ///< Time until the last shard finished.
+    double mergeMs = 0; ///< Time spent merging partial maps.
+};
+
+/**
+ * @brief Loads block states, definitions and models from disk.
+ *
+ * All three folders are enumerated up front into one job list. Shards then
+ * pull jobs from a shared counter (so slow files do not stall a fixed split)
+ * and parse them into their own partial map. The calling thread runs one
+ * shard itself and, after the others finish, merges the partial maps in a
+ * single pass. No lock is taken while parsing.
+ *
+ * @note Like the sequential loader it replaces, the first file that fails to
+ *       parse is rethrown after all shards have stopped. With
+ *       @c diagnosticsMode set, failing files are skipped and reported by
+ *       @ref GetLastErrors() instead.
+ */
+class BlockJsonLoader
+{
+public:
+    /** @brief Kind of block JSON file, given by its folder. */
+    enum class FileKind
+    {
+        State,
+        Definition,
+        Model
+    };
+
+    /**
+     * @param logger Logger used for per-file errors and the load summary.
+     * @param config Parallelism settings.
+     */
+    BlockJsonLoader(ILogger &logger, const BlockJsonDataCacheConfig &config = {});
+
+    /**
+     * @brief Parses every `.json` file of the three folders.
+     *
+     * Model files are named `blockName_modelName.json`; files without an
+     * underscore are ignored.
+     * With @c lazyModels set in the config, model files are skipped; see
+     * @ref BlockModelStore.
+     *
+     * @return Map from block name to its merged data.
+     *
+     * @throws std::filesystem::filesystem_error If a directory cannot be accessed.
+     * @throws std::runtime_error If any JSON file cannot be parsed, unless
+     *         @c diagnosticsMode is set.
+     */
+    std::unordered_map<std::string, BlockJsonData> LoadAll(const std::filesystem::path &statesFolder,
+                                                           const std::filesystem::path &definitionsFolder,
+                                                           const std::filesystem::path &modelsFolder);
+
+    /**
+     * @brief Parses a single file into the matching part of @p data.
+     *
+     * Used by hot reload. @p modelName is the file stem for models and
+     * ignored otherwise.
+     *
+     * @throws std::runtime_error If the file cannot be opened or parsed.
+     */
+    void LoadFile(FileKind kind, const std::filesystem::path &path, BlockJsonData &data,
+                  const std::string &modelName = {});
+
+    /**
+     * @brief Parses and validates one model file.
+     *
+     * Used by @ref BlockModelStore to load models on demand.
+     *
+     * @throws std::runtime_error If the file cannot be opened, parsed or validated.
+     */
+    BlockModel LoadModel(const std::filesystem::path &path);
+
+    /**
+     * @brief Calls @p work for every index below @p count, spread over shards
+     *        the same way as LoadAll().
+     *
+     * @p work receives the shard number (0 is the calling thread, all are
+     * below ShardCount(count)) and the index; it must not throw. Returning
+     * @c false stops all shards after their current item.
+     */
+    void RunSharded(size_t count, const std::function<bool(size_t shard, size_t index)> &work) const;
+
+    /** @brief Number of shards RunSharded() uses for @p count items, the calling thread included. */
+    size_t ShardCount(size_t count) const;
+
+    /** @brief Returns timings of the last LoadAll() call. */
+    const BlockJsonLoadStats &GetLastStats() const noexcept { return stats_; }
+
+    /** @brief Files skipped by the last LoadAll() call in diagnostics mode, in enumeration order. */
+    const std::vector<BlockDiagnostic> &GetLastErrors() const noexcept { return errors_; }
+
+private:
+    /** @brief One file to parse. */
+    struct Job
+    {
+        FileKind kind;
+        std::filesystem::path path;
+        std::string blockName;
+        std::string modelName;
+    };
+
+    /**
+     * @brief Loads and parses a JSON file into an object of the specified type.
+     *
+     * @throws std::runtime_error If the file cannot be opened or parsed.
+     */
+    template <typename T>
+    T LoadJsonFile(const std::filesystem::path &path);
+
+    /** @brief Collects `.json` files of all three folders. */
+    static std::vector<Job> Enumerate(const std::filesystem::path &statesFolder,
+                                      const std::filesystem::path &definitionsFolder,
+                                      const std::filesystem::path &modelsFolder);
+
+    /** @brief Parses one file into @p partial. */
+    void RunJob(const Job &job, std::unordered_map<std::string, BlockJsonData> &partial);
+
+    /** @brief Pool to run shards on, or @c nullptr when parallel loading is off. */
+    ThreadPool *Pool() const;
+
+    ILogger &logger_;
+    BlockJsonDataCacheConfig config_;
+    BlockJsonLoadStats stats_;
+    std::vector<BlockDiagnostic> errors_;
+};
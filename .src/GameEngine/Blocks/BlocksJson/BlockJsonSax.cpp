@@ -0,0 +1,575 @@
+#include "BlockJsonSax.h"
+
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /** @brief A scalar JSON value delivered by the SAX parser. */
+    struct SaxValue
+    {
+        enum class Kind
+        {
+            Null,
+            Boolean,
+            Number,
+            String
+        };
+
+        Kind kind = Kind::Null;
+        bool boolean = false;
+        double number = 0.0;
+        std::string *string = nullptr; ///< Owned by the parser; may be moved from.
+    };
+
+    [[noreturn]] void TypeError(std::string_view field, std::string_view expected)
+    {
+        throw std::invalid_argument(std::string("type must be ") + std::string(expected) +
+                                    " for '" + std::string(field) + "'");
+    }
+
+    /**
+     * @brief Tracks the position in the document and forwards events with it.
+     *
+     * Implements the nlohmann SAX interface. Subclasses see scalars through
+     * OnValue() and containers through OnBegin()/OnEnd(), and match the
+     * current position with At().
+     */
+    class PathSaxHandler
+    {
+    public:
+        using number_integer_t = json::number_integer_t;
+        using number_unsigned_t = json::number_unsigned_t;
+        using number_float_t = json::number_float_t;
+        using string_t = json::string_t;
+        using binary_t = json::binary_t;
+
+        virtual ~PathSaxHandler() = default;
+
+        bool null() { return Scalar({}); }
+        bool boolean(bool value) { return Scalar({SaxValue::Kind::Boolean, value}); }
+        bool number_integer(number_integer_t value) { return Number(static_cast<double>(value)); }
+        bool number_unsigned(number_unsigned_t value) { return Number(static_cast<double>(value)); }
+        bool number_float(number_float_t value, const string_t &) { return Number(value); }
+        bool string(string_t &value) { return Scalar({SaxValue::Kind::String, false, 0.0, &value}); }
+        bool binary(binary_t &) { return true; } // never produced by JSON text
+
+        bool start_object(std::size_t) { return Begin(false); }
+        bool start_array(std::size_t) { return Begin(true); }
+        bool end_object() { return End(); }
+        bool end_array() { return End(); }
+
+        bool key(string_t &key)
+        {
+            key_ = std::move(key);
+            return true;
+        }
+
+        bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &e)
+        {
+            throw std::runtime_error(e.what());
+        }
+
+    protected:
+        virtual void OnValue(SaxValue &value) = 0;
+        virtual void OnBegin(bool /*array*/) {}
+        virtual void OnEnd(bool /*array*/, size_t /*count*/) {}
+
+        /**
+         * @brief Matches the current position below the root.
+         *
+         * Each pattern entry is an object key, "*" for any key or "[]" for
+         * any array slot; e.g. `{"elements", "[]", "faces", "*"}`.
+         */
+        bool At(std::initializer_list<std::string_view> pattern) const
+        {
+            if (pattern.size() != stack_.size())
+                return false;
+
+            auto it = pattern.begin();
+            for (size_t level = 0; level < stack_.size(); ++level, ++it)
+            {
+                const std::string_view name = level + 1 < stack_.size() ? stack_[level + 1].name : key_;
+                const bool match = stack_[level].array ? *it == "[]" : (*it == "*" || *it == name);
+                if (!match)
+                    return false;
+            }
+            return true;
+        }
+
+        /** @brief Object key of the current position. */
+        const std::string &Key() const noexcept { return key_; }
+
+        /** @brief Array index of the current position. */
+        size_t Index() const noexcept { return stack_.back().next; }
+
+    private:
+        /** @brief An open container and where it sits in its parent. */
+        struct Frame
+        {
+            bool array;
+            std::string name; ///< Key in the parent object; empty in an array.
+            size_t next = 0;  ///< Index of the next array slot.
+        };
+
+        bool Number(double value) { return Scalar({SaxValue::Kind::Number, false, value}); }
+
+        bool Scalar(SaxValue value)
+        {
+            OnValue(value);
+            Advance();
+            return true;
+        }
+
+        bool Begin(bool array)
+        {
+            OnBegin(array);
+            const bool inObject = !stack_.empty() && !stack_.back().array;
+            stack_.push_back({array, inObject ? key_ : std::string()});
+            return true;
+        }
+
+        bool End()
+        {
+            Frame frame = std::move(stack_.back());
+            stack_.pop_back();
+            key_ = std::move(frame.name); // At() now refers to the closed container
+            OnEnd(frame.array, frame.next);
+            Advance();
+            return true;
+        }
+
+        void Advance()
+        {
+            if (!stack_.empty() && stack_.back().array)
+                ++stack_.back().next;
+        }
+
+        std::vector<Frame> stack_;
+        std::string key_;
+    };
+
+    /** @brief Runs @p handler over @p text; lenient about trailing text, like `file >> j`. */
+    template <typename Handler>
+    void Run(std::string_view text, Handler &handler)
+    {
+        json::sax_parse(text, &handler, json::input_format_t::json, /*strict*/ false);
+    }
+
+    // ------------------------------------------------------------------------
+    // BlockDefinition
+    // ------------------------------------------------------------------------
+
+    class DefinitionHandler final : public PathSaxHandler
+    {
+    public:
+        BlockDefinition definition;
+
+    protected:
+        void OnValue(SaxValue &value) override
+        {
+            if (value.kind != SaxValue::Kind::Boolean)
+                return;
+
+            if (At({"isTransparent"}))
+                definition.isTransparent = value.boolean;
+            else if (At({"isSolid"}))
+                definition.isSolid = value.boolean;
+            else if (At({"isOpaque"}))
+                definition.isOpaque = value.boolean;
+            else if (At({"isFullCube"}))
+                definition.isFullCube = value.boolean;
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    // BlockState
+    // ------------------------------------------------------------------------
+
+    class StateHandler final : public PathSaxHandler
+    {
+    public:
+        BlockState state;
+
+    protected:
+        void OnValue(SaxValue &value) override
+        {
+            if (At({"properties", "*"}))
+                Put(state.properties, value);
+            else if (At({"variants", "*"}))
+                Put(state.variants, value);
+        }
+
+        void OnBegin(bool) override
+        {
+            if (At({"properties", "*"}) || At({"variants", "*"}))
+                TypeError(Key(), "string");
+        }
+
+    private:
+        template <typename Map>
+        void Put(Map &map, SaxValue &value)
+        {
+            if (value.kind != SaxValue::Kind::String)
+                TypeError(Key(), "string");
+            map[typename Map::key_type(Key())] = typename Map::mapped_type(std::move(*value.string));
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    // BlockModel
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief Fills either model kind in one pass.
+     *
+     * The kind is only known once "credit" is seen, which may come after
+     * the elements. Blockbench exports write it first, so elements that
+     * follow a credit are parsed straight into @ref BlockElement; otherwise
+     * they are captured as raw JSON, which is what vanilla models keep.
+     */
+    class ModelHandler final : public PathSaxHandler
+    {
+    public:
+        BlockModel Finish()
+        {
+            BlockModel model;
+            if (hasCredit_)
+            {
+                model.isBlockbench = true;
+                bb_.formatVersion = std::move(formatVersion_);
+                bb_.textures = std::move(textures_);
+                if (elementsMode_ == ElementsMode::Captured)
+                    captured_.get_to(bb_.elements);
+                model.data = std::move(bb_);
+            }
+            else
+            {
+                if (!parentError_.empty())
+                    throw std::invalid_argument(parentError_);
+
+                DefaultTemplateModel def;
+                def.parent = std::move(parent_);
+                def.formatVersion = std::move(formatVersion_);
+                def.textures = std::move(textures_);
+                def.elements = std::move(captured_);
+                model.data = std::move(def);
+            }
+            model.wasLoaded = true;
+            return model;
+        }
+
+    protected:
+        void OnValue(SaxValue &value) override
+        {
+            if (!capture_.empty())
+            {
+                Insert(ToJson(value));
+                return;
+            }
+
+            if (elementsMode_ == ElementsMode::Direct && ElementValue(value))
+                return;
+
+            if (At({"credit"}))
+            {
+                if (value.kind == SaxValue::Kind::String)
+                {
+                    hasCredit_ = true;
+                    bb_.credit = std::move(*value.string);
+                }
+            }
+            else if (At({"format_version"}))
+            {
+                if (value.kind != SaxValue::Kind::String)
+                    TypeError("format_version", "string");
+                formatVersion_ = std::move(*value.string);
+            }
+            else if (At({"parent"}))
+            {
+                if (value.kind == SaxValue::Kind::String)
+                    parent_ = std::move(*value.string);
+                else
+                    parentError_ = "type must be string for 'parent'";
+            }
+            else if (At({"textures"}))
+            {
+                TypeError("textures", "object");
+            }
+            else if (At({"textures", "*"}))
+            {
+                if (value.kind != SaxValue::Kind::String)
+                    TypeError(Key(), "string");
+                textures_[Symbol(Key())] = Symbol(*value.string);
+            }
+            else if (At({"elements"}))
+            {
+                if (hasCredit_)
+                    TypeError("elements", "array");
+                captured_ = ToJson(value);
+                elementsMode_ = ElementsMode::Captured;
+            }
+        }
+
+        void OnBegin(bool array) override
+        {
+            if (!capture_.empty())
+            {
+                capture_.push_back(&Insert(array ? json::array() : json::object()));
+                return;
+            }
+
+            if (elementsMode_ == ElementsMode::Direct && ElementBegin(array))
+                return;
+
+            if (At({"elements"}))
+            {
+                if (hasCredit_)
+                {
+                    if (!array)
+                        TypeError("elements", "array");
+                    bb_.elements.clear();
+                    elementsMode_ = ElementsMode::Direct;
+                }
+                else
+                {
+                    captured_ = array ? json::array() : json::object();
+                    capture_.push_back(&captured_);
+                    elementsMode_ = ElementsMode::Captured;
+                }
+            }
+            else if (At({"textures"}))
+            {
+                if (array)
+                    TypeError("textures", "object");
+            }
+            else if (At({"textures", "*"}))
+            {
+                TypeError(Key(), "string");
+            }
+            else if (At({"format_version"}))
+            {
+                TypeError("format_version", "string");
+            }
+            else if (At({"parent"}))
+            {
+                parentError_ = "type must be string for 'parent'";
+            }
+        }
+
+        void OnEnd(bool array, size_t count) override
+        {
+            if (!capture_.empty())
+            {
+                capture_.pop_back();
+                return;
+            }
+
+            if (elementsMode_ != ElementsMode::Direct || !array)
+                return;
+
+            // Same checks as get_to(std::array): too few values is an error.
+            if (At({"elements"}))
+            {
+                bb_.elements.shrink_to_fit(); // sized exactly, like the DOM path
+            }
+            else if (At({"elements", "[]", "from"}) || At({"elements", "[]", "to"}) ||
+                At({"elements", "[]", "rotation", "origin"}))
+            {
+                if (count < 3)
+                    throw std::out_of_range("expected 3 values for '" + Key() + "'");
+            }
+            else if (At({"elements", "[]", "faces", "*", "uv"}))
+            {
+                if (count < 4)
+                    throw std::out_of_range("expected 4 values for 'uv'");
+            }
+        }
+
+    private:
+        enum class ElementsMode
+        {
+            None,
+            Direct,  ///< Parsing into bb_.elements.
+            Captured ///< Kept as raw JSON in captured_.
+        };
+
+        static json ToJson(SaxValue &value)
+        {
+            switch (value.kind)
+            {
+            case SaxValue::Kind::Boolean:
+                return value.boolean;
+            case SaxValue::Kind::Number:
+                return value.number;
+            case SaxValue::Kind::String:
+                return std::move(*value.string);
+            case SaxValue::Kind::Null:
+            default:
+                return nullptr;
+            }
+        }
+
+        /** @brief Adds @p value to the innermost captured container. */
+        json &Insert(json &&value)
+        {
+            json &parent = *capture_.back();
+            if (parent.is_array())
+            {
+                parent.push_back(std::move(value));
+                return parent.back();
+            }
+            return parent[Key()] = std::move(value);
+        }
+
+        static float ToFloat(const SaxValue &value, std::string_view field)
+        {
+            if (value.kind != SaxValue::Kind::Number)
+                TypeError(field, "number");
+            return static_cast<float>(value.number);
+        }
+
+        template <size_t N>
+        void Store(std::array<float, N> &target, const SaxValue &value, std::string_view field)
+        {
+            const float v = ToFloat(value, field);
+            if (Index() < N)
+                target[Index()] = v;
+        }
+
+        /** @brief Handles a scalar inside "elements"; false if it is not part of an element. */
+        bool ElementValue(SaxValue &value)
+        {
+            if (At({"elements", "[]"}))
+            {
+                bb_.elements.emplace_back(); // from_json on a non-object reads nothing
+                return true;
+            }
+            if (bb_.elements.empty())
+                return false;
+
+            BlockElement &element = bb_.elements.back();
+
+            if (At({"elements", "[]", "from", "[]"}))
+                Store(element.from, value, "from");
+            else if (At({"elements", "[]", "to", "[]"}))
+                Store(element.to, value, "to");
+            else if (At({"elements", "[]", "from"}) || At({"elements", "[]", "to"}))
+                TypeError(Key(), "array");
+            else if (At({"elements", "[]", "rotation", "angle"}))
+                element.rotation.angle = ToFloat(value, "angle");
+            else if (At({"elements", "[]", "rotation", "axis"}))
+            {
+                if (value.kind != SaxValue::Kind::String)
+                    TypeError("axis", "string");
+                element.rotation.axis = std::move(*value.string);
+            }
+            else if (At({"elements", "[]", "rotation", "origin", "[]"}))
+                Store(element.rotation.origin, value, "origin");
+            else if (At({"elements", "[]", "rotation", "origin"}))
+                TypeError("origin", "array");
+            else if (At({"elements", "[]", "faces"}))
+                TypeError("faces", "object");
+            else if (At({"elements", "[]", "faces", "*"}))
+                element.faces[Key()] = {};
+            else if (face_ && At({"elements", "[]", "faces", "*", "uv", "[]"}))
+                Store(face_->uv, value, "uv");
+            else if (face_ && value.kind == SaxValue::Kind::String && At({"elements", "[]", "faces", "*", "texture"}))
+                face_->texture = Symbol(*value.string);
+            else if (face_ && value.kind == SaxValue::Kind::String && At({"elements", "[]", "faces", "*", "cullface"}))
+                face_->cullface = std::move(*value.string);
+            else
+                return !IsRootField();
+
+            return true;
+        }
+
+        /** @brief Handles a container inside "elements"; false if it is not part of an element. */
+        bool ElementBegin(bool array)
+        {
+            if (At({"elements", "[]"}))
+            {
+                bb_.elements.emplace_back();
+                face_ = nullptr;
+                return true;
+            }
+            if (bb_.elements.empty())
+                return false;
+
+            BlockElement &element = bb_.elements.back();
+
+            if (At({"elements", "[]", "from"}) || At({"elements", "[]", "to"}) ||
+                At({"elements", "[]", "rotation", "origin"}))
+            {
+                if (!array)
+                    TypeError(Key(), "array");
+            }
+            else if (At({"elements", "[]", "faces"}))
+            {
+                if (array)
+                    TypeError("faces", "object");
+            }
+            else if (At({"elements", "[]", "faces", "*"}))
+            {
+                face_ = &element.faces[Key()];
+                if (array)
+                    face_ = nullptr; // from_json on a non-object reads nothing
+            }
+            else if (At({"elements", "[]", "rotation", "angle"}))
+                TypeError("angle", "number");
+            else if (At({"elements", "[]", "rotation", "axis"}))
+                TypeError("axis", "string");
+            else if (At({"elements", "[]", "from", "[]"}) || At({"elements", "[]", "to", "[]"}) ||
+                     At({"elements", "[]", "rotation", "origin", "[]"}) ||
+                     (face_ && At({"elements", "[]", "faces", "*", "uv", "[]"})))
+                TypeError(Key(), "number");
+            else
+                return !IsRootField();
+
+            return true;
+        }
+
+        bool IsRootField() const
+        {
+            return At({"credit"}) || At({"format_version"}) || At({"parent"}) || At({"textures"}) ||
+                   At({"textures", "*"}) || At({"elements"});
+        }
+
+        bool hasCredit_ = false;
+        std::string formatVersion_;
+        std::string parent_;
+        std::string parentError_; ///< Only an error if the model turns out to be vanilla.
+        std::unordered_map<Symbol, Symbol> textures_;
+        BlockBenchModel bb_;
+
+        ElementsMode elementsMode_ = ElementsMode::None;
+        BlockFace *face_ = nullptr; ///< Face being filled in Direct mode.
+        json captured_;
+        std::vector<json *> capture_; ///< Open containers of captured_.
+    };
+}
+
+BlockDefinition JsonSaxReader<BlockDefinition>::Parse(std::string_view text)
+{
+    DefinitionHandler handler;
+    Run(text, handler);
+    handler.definition.wasLoaded = true;
+    return std::move(handler.definition);
+}
+
+BlockState JsonSaxReader<BlockState>::Parse(std::string_view text)
+{
+    StateHandler handler;
+    Run(text, handler);
+    handler.state.wasLoaded = true;
+    return std::move(handler.state);
+}
+
+BlockModel JsonSaxReader<BlockModel>::Parse(std::string_view text)
+{
+    ModelHandler handler;
+    Run(text, handler);
+    return handler.Finish();
+}
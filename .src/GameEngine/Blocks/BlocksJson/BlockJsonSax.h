@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string_view>
+
+#include "JsonParseMode.h"
+#include "BlockDefinitionConfig.h"
+#include "BlockModelConfig.h"
+#include "BlockStateConfig.h"
+
+/**
+ * @brief Streaming readers for the block JSON files.
+ *
+ * They walk nlohmann's SAX events and fill the config structs directly,
+ * without building a @c json tree first. Results match the `from_json`
+ * overloads, including their type errors. The one exception is the
+ * `elements` array of vanilla-style models: it is kept as raw JSON in
+ * @ref DefaultTemplateModel, so that subtree alone is still built as a tree.
+ *
+ * Set a trait below back to @c JsonParseMode::Dom to compare or debug.
+ */
+
+template <>
+struct JsonSaxReader<BlockDefinition>
+{
+    static BlockDefinition Parse(std::string_view text);
+};
+
+template <>
+struct JsonSaxReader<BlockState>
+{
+    static BlockState Parse(std::string_view text);
+};
+
+template <>
+struct JsonSaxReader<BlockModel>
+{
+    static BlockModel Parse(std::string_view text);
+};
+
+template <>
+struct JsonParseTraits<BlockDefinition>
+{
+    static constexpr JsonParseMode mode = JsonParseMode::Sax;
+};
+
+template <>
+struct JsonParseTraits<BlockState>
+{
+    static constexpr JsonParseMode mode = JsonParseMode::Sax;
+};
+
+template <>
+struct JsonParseTraits<BlockModel>
+{
+    static constexpr JsonParseMode mode = JsonParseMode::Sax;
+};
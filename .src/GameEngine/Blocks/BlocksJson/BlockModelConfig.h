@@ -9,6 +9,7 @@
 #include <nlohmann/json.hpp>
 
 #include "JsonLoadable.h"
+#include "Symbol.h"
 #include "IDebugPrintable.h"
 #include "DebugHelpers.h"
 
@@ -24,13 +25,14 @@ using nlohmann::json;
 struct BlockFace : public IDebugPrintable
 {
     std::array<float, 4> uv{}; ///< UV coordinates of the face.
-    std::string texture;       ///< Texture reference name.
+    Symbol texture;            ///< Texture reference name.
+    std::string cullface;      ///< Neighbour direction that hides this face; empty if never culled.
 
     /// @copydoc IDebugPrintable::ToShortString
     std::string ToShortString() const override
     {
         using namespace DebugHelpers;
-        return std::format("Face(uv={}, tex={})", Arr4ToStr(uv), texture);
+        return std::format("Face(uv={}, tex={}, cull={})", Arr4ToStr(uv), texture, cullface);
     }
 
     /// @copydoc IDebugPrintable::ToPrettyString
@@ -42,7 +44,9 @@ struct BlockFace : public IDebugPrintable
         std::ostringstream ss;
         ss << Title("BlockFace") << " " << Brace("{\n");
         ss << "  " << Key("uv") << " = " << Value(Arr4ToStr(uv)) << "\n";
-        ss << "  " << Key("texture") << " = " << Value(texture) << "\n";
+        ss << "  " << Key("texture") << " = " << Value(texture.Str()) << "\n";
+        if (!cullface.empty())
+            ss << "  " << Key("cullface") << " = " << Value(cullface) << "\n";
         ss << Brace("}");
         return ss.str();
     }
@@ -119,7 +123,7 @@ struct BlockBenchModel : public IDebugPrintable
 {
     std::string formatVersion;                             ///< Format version string.
     std::string credit;                                    ///< Author or credits.
-    std::unordered_map<std::string, std::string> textures; ///< Texture mapping.
+    std::unordered_map<Symbol, Symbol> textures;           ///< Texture mapping.
     std::vector<BlockElement> elements;                    ///< List of model elements.
 
     /// @copydoc IDebugPrintable::ToShortString
@@ -175,7 +179,7 @@ struct BlockBenchModel : public IDebugPrintable
 struct DefaultTemplateModel : public IDebugPrintable
 {
     std::string parent;                                    ///< Name of the parent model (optional).
-    std::unordered_map<std::string, std::string> textures; ///< Texture mappings.
+    std::unordered_map<Symbol, Symbol> textures;           ///< Texture mappings.
     json elements;                                         ///< Raw JSON definition of model elements.
     std::string formatVersion;                             ///< Optional format version.
 
@@ -262,6 +266,9 @@ inline void from_json(const json &j, BlockFace &f)
 
     if (j.contains("texture") && j["texture"].is_string())
         j.at("texture").get_to(f.texture);
+
+    if (j.contains("cullface") && j["cullface"].is_string())
+        j.at("cullface").get_to(f.cullface);
 }
 
 /**
@@ -0,0 +1,309 @@
+#include "BlockModelStore.h"
+#include "LogMacros.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Per-statement budget: a broken resource pack must not flood the log.
+    constexpr uint32_t MODEL_ERRORS_PER_SECOND = 20;
+
+    size_t EstimateJsonBytes(const json &j)
+    {
+        size_t bytes = sizeof(json);
+        if (j.is_string())
+            bytes += j.get_ref<const std::string &>().capacity();
+        else if (j.is_array())
+            for (const json &item : j)
+                bytes += EstimateJsonBytes(item);
+        else if (j.is_object())
+            for (const auto &[key, item] : j.items())
+                bytes += key.size() + 32 + EstimateJsonBytes(item); // + map node
+        return bytes;
+    }
+
+    /**
+     * @brief Approximate heap size of a parsed model.
+     *
+     * Counts the structs, face map nodes and strings; symbols are shared
+     * and not charged to any model.
+     */
+    size_t EstimateModelBytes(const BlockModel &model)
+    {
+        constexpr size_t MAP_NODE = 32;
+        size_t bytes = sizeof(BlockModel);
+
+        if (model.isBlockbench)
+        {
+            const auto &bb = std::get<BlockBenchModel>(model.data);
+            bytes += bb.formatVersion.capacity() + bb.credit.capacity();
+            bytes += bb.textures.size() * (sizeof(std::pair<const Symbol, Symbol>) + MAP_NODE);
+            bytes += bb.elements.capacity() * sizeof(BlockElement);
+            for (const BlockElement &element : bb.elements)
+            {
+                bytes += element.rotation.axis.capacity();
+                for (const auto &[name, face] : element.faces)
+                    bytes += sizeof(std::pair<const std::string, BlockFace>) + MAP_NODE + name.capacity() +
+                             face.cullface.capacity();
+            }
+        }
+        else
+        {
+            const auto &def = std::get<DefaultTemplateModel>(model.data);
+            bytes += def.parent.capacity() + def.formatVersion.capacity();
+            bytes += def.textures.size() * (sizeof(std::pair<const Symbol, Symbol>) + MAP_NODE);
+            bytes += EstimateJsonBytes(def.elements);
+        }
+
+        return bytes;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// BlockModelHandle
+// ----------------------------------------------------------------------------
+
+BlockModelHandle::BlockModelHandle(BlockModelHandle &&other) noexcept
+    : store_(std::exchange(other.store_, nullptr)), name_(other.name_), model_(std::move(other.model_))
+{
+}
+
+BlockModelHandle &BlockModelHandle::operator=(BlockModelHandle &&other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        store_ = std::exchange(other.store_, nullptr);
+        name_ = other.name_;
+        model_ = std::move(other.model_);
+    }
+    return *this;
+}
+
+void BlockModelHandle::Release() noexcept
+{
+    model_.reset();
+    if (store_)
+        std::exchange(store_, nullptr)->Unpin(name_);
+}
+
+// ----------------------------------------------------------------------------
+// BlockModelStore
+// ----------------------------------------------------------------------------
+
+BlockModelStore::BlockModelStore(ILogger &logger, std::filesystem::path modelsFolder, size_t budgetBytes,
+                                 const BlockJsonDataCacheConfig &config)
+    : logger_(logger), modelsFolder_(std::move(modelsFolder)), loader_(logger, config), budget_(budgetBytes)
+{
+    for (const auto &entry : std::filesystem::directory_iterator(modelsFolder_))
+    {
+        if (entry.is_regular_file())
+            OnFileChanged(entry.path());
+    }
+
+    LOG_INFO(logger_, LogCategory::Json, "Indexed {} block models for on-demand loading ({} KB budget)",
+             stats_.known, budget_ / 1024);
+}
+
+bool BlockModelStore::ParseFileName(const std::filesystem::path &file, std::string &blockName,
+                                    std::string &modelName)
+{
+    // Same naming rule as BlockJsonLoader: `blockName_modelName.json`.
+    if (file.extension() != ".json")
+        return false;
+
+    modelName = file.stem().string();
+    const size_t underscorePos = modelName.find('_');
+    if (underscorePos == std::string::npos)
+        return false;
+
+    blockName = modelName.substr(0, underscorePos);
+    return true;
+}
+
+BlockModelHandle BlockModelStore::Acquire(Symbol name)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto it = entries_.find(name);
+    if (it == entries_.end())
+        return {};
+    Entry &entry = it->second;
+
+    loaded_.wait(lock, [&] { return !entry.loading; });
+
+    if (entry.model)
+    {
+        ++stats_.hits;
+        return PinLocked(name, entry);
+    }
+    if (entry.failed || entry.file.empty())
+        return {};
+
+    // Parse without the lock; other requests for this model wait on loaded_.
+    ++stats_.misses;
+    entry.loading = true;
+    const std::filesystem::path file = entry.file;
+    const uint32_t generation = entry.generation;
+    lock.unlock();
+
+    std::shared_ptr<const BlockModel> model;
+    try
+    {
+        model = std::make_shared<const BlockModel>(loader_.LoadModel(file));
+    }
+    catch (const std::exception &e)
+    {
+        // The loader already logged the parse error; say what it means here.
+        LOG_WARNING_RATE_LIMITED(logger_, LogCategory::Json, MODEL_ERRORS_PER_SECOND,
+                                 "Model {} is unavailable until its file changes ({})", name, e.what());
+    }
+
+    lock.lock();
+    entry.loading = false;
+    loaded_.notify_all();
+
+    if (entry.generation != generation)
+    {
+        // The file changed while it was parsed: the result, or the failure, belongs
+        // to the old contents. Discard it and read the current file.
+        lock.unlock();
+        return Acquire(name);
+    }
+
+    if (!model)
+    {
+        entry.failed = true;
+        ++stats_.failures;
+        return {};
+    }
+
+    entry.model = std::move(model);
+    entry.bytes = EstimateModelBytes(*entry.model);
+    stats_.bytes += entry.bytes;
+    ++stats_.resident;
+
+    BlockModelHandle handle = PinLocked(name, entry);
+    EvictLocked();
+    return handle;
+}
+
+BlockModelHandle BlockModelStore::PinLocked(Symbol name, Entry &entry)
+{
+    if (entry.inLru)
+    {
+        lru_.erase(entry.lruIt);
+        entry.inLru = false;
+    }
+    if (entry.pins++ == 0)
+        ++stats_.pinned;
+
+    return BlockModelHandle(this, name, entry.model);
+}
+
+void BlockModelStore::Unpin(Symbol name) noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = entries_.find(name);
+    if (it == entries_.end() || it->second.pins == 0)
+        return;
+
+    Entry &entry = it->second;
+    if (--entry.pins > 0)
+        return;
+
+    --stats_.pinned;
+    if (entry.model)
+    {
+        lru_.push_front(name);
+        entry.lruIt = lru_.begin();
+        entry.inLru = true;
+        EvictLocked();
+    }
+}
+
+void BlockModelStore::DropLocked(Entry &entry)
+{
+    if (!entry.model)
+        return;
+
+    if (entry.inLru)
+    {
+        lru_.erase(entry.lruIt);
+        entry.inLru = false;
+    }
+    entry.model.reset();
+    stats_.bytes -= entry.bytes;
+    entry.bytes = 0;
+    --stats_.resident;
+}
+
+void BlockModelStore::EvictLocked()
+{
+    while (stats_.bytes > budget_ && !lru_.empty())
+    {
+        DropLocked(entries_.at(lru_.back()));
+        ++stats_.evictions;
+    }
+}
+
+std::vector<Symbol> BlockModelStore::GetModelNames(const std::string &blockName) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = blockModels_.find(blockName);
+    if (it == blockModels_.end())
+        return {};
+
+    std::vector<Symbol> names = it->second;
+    std::sort(names.begin(), names.end(), [](Symbol a, Symbol b) { return a.View() < b.View(); });
+    return names;
+}
+
+Symbol BlockModelStore::OnFileChanged(const std::filesystem::path &file)
+{
+    std::string blockName, modelName;
+    if (!ParseFileName(file, blockName, modelName))
+        return {};
+
+    const Symbol name(modelName);
+    std::error_code ec;
+    const bool exists = std::filesystem::is_regular_file(file, ec);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto [it, inserted] = entries_.try_emplace(name);
+    Entry &entry = it->second;
+    std::vector<Symbol> &names = blockModels_[blockName];
+
+    if (exists && entry.file.empty())
+    {
+        ++stats_.known;
+        names.push_back(name);
+    }
+    else if (!exists && !entry.file.empty())
+    {
+        --stats_.known;
+        std::erase(names, name);
+    }
+
+    entry.file = exists ? file : std::filesystem::path{};
+    entry.failed = false;
+    ++entry.generation; // a load in flight discards its result
+    DropLocked(entry);
+    return name;
+}
+
+void BlockModelStore::SetBudget(size_t budgetBytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_ = budgetBytes;
+    EvictLocked();
+}
+
+BlockModelStore::Stats BlockModelStore::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BlockJsonLoader.h"
+#include "BlockModelConfig.h"
+#include "ILogger.h"
+#include "Symbol.h"
+
+class BlockModelStore;
+
+/**
+ * @brief Pins one block model while it is in use.
+ *
+ * A pinned model is never evicted from its @ref BlockModelStore. Keep the
+ * handle as long as something (e.g. a chunk mesh) is built from the model,
+ * and drop it to make the model evictable again. Move-only.
+ *
+ * A handle without a store (eager mode) only keeps the data alive.
+ */
+class BlockModelHandle
+{
+public:
+    BlockModelHandle() = default;
+    ~BlockModelHandle() { Release(); }
+
+    BlockModelHandle(const BlockModelHandle &) = delete;
+    BlockModelHandle &operator=(const BlockModelHandle &) = delete;
+
+    BlockModelHandle(BlockModelHandle &&other) noexcept;
+    BlockModelHandle &operator=(BlockModelHandle &&other) noexcept;
+
+    /** @brief Unpins the model now instead of on destruction. */
+    void Release() noexcept;
+
+    const BlockModel *Get() const noexcept { return model_.get(); }
+    const BlockModel &operator*() const noexcept { return *model_; }
+    const BlockModel *operator->() const noexcept { return model_.get(); }
+    explicit operator bool() const noexcept { return model_ != nullptr; }
+
+    /** @brief Name of the pinned model. */
+    Symbol GetName() const noexcept { return name_; }
+
+private:
+    friend class BlockModelStore;
+    friend class BlockJsonDataCache;
+
+    BlockModelHandle(BlockModelStore *store, Symbol name, std::shared_ptr<const BlockModel> model) noexcept
+        : store_(store), name_(name), model_(std::move(model))
+    {
+    }
+
+    BlockModelStore *store_ = nullptr;
+    Symbol name_;
+    std::shared_ptr<const BlockModel> model_;
+};
+
+/**
+ * @brief Loads block models on first use and keeps them in a size-bounded LRU.
+ *
+ * Only the model folder is scanned up front (file names, no parsing).
+ * @ref Acquire() parses a model the first time it is requested and pins it.
+ * When the last handle of a model is released, the model moves to the front
+ * of an LRU list; models at the back are freed once the resident size
+ * exceeds the budget. Memory therefore follows the set of models in use,
+ * not the size of the pack.
+ *
+ * Pinned models are never evicted, so the budget can be exceeded while
+ * more models than it allows are pinned. Models that fail to parse or
+ * validate are logged once and return an empty handle until their file
+ * changes.
+ *
+ * Thread-safe. Concurrent requests for the same model parse it once. The
+ * store must outlive every handle it hands out.
+ *
+ * @code
+ * BlockModelStore store(logger, modelsFolder, 64 << 20);
+ * BlockModelHandle model = store.Acquire(Symbol("dirt_v"));
+ * if (model)
+ *     compiler.AddModel(model.GetName().View(), *model);
+ * @endcode
+ */
+class BlockModelStore
+{
+public:
+    /** @brief Counters for tuning the budget. */
+    struct Stats
+    {
+        size_t known = 0;       ///< Model files found in the folder.
+        size_t resident = 0;    ///< Models currently parsed in memory.
+        size_t pinned = 0;      ///< Models with at least one handle.
+        size_t bytes = 0;       ///< Estimated size of the resident models.
+        uint64_t hits = 0;      ///< Requests served from memory.
+        uint64_t misses = 0;    ///< Requests that parsed a file.
+        uint64_t evictions = 0; ///< Models freed to stay within the budget.
+        uint64_t failures = 0;  ///< Files that failed to parse or validate.
+    };
+
+    /**
+     * @param logger       Receives parse errors.
+     * @param modelsFolder Folder with `blockName_modelName.json` files.
+     * @param budgetBytes  Resident size above which unpinned models are evicted.
+     * @param config       Loader options.
+     *
+     * @throws std::filesystem::filesystem_error If the folder cannot be read.
+     */
+    BlockModelStore(ILogger &logger, std::filesystem::path modelsFolder, size_t budgetBytes,
+                    const BlockJsonDataCacheConfig &config = {});
+
+    BlockModelStore(const BlockModelStore &) = delete;
+    BlockModelStore &operator=(const BlockModelStore &) = delete;
+
+    /**
+     * @brief Pins model @p name, parsing its file if it is not resident.
+     *
+     * @return The pinned model, or an empty handle if there is no such file
+     *         or it is invalid.
+     */
+    BlockModelHandle Acquire(Symbol name);
+
+    /** @brief Names of the model files of @p blockName, sorted by text. */
+    std::vector<Symbol> GetModelNames(const std::string &blockName) const;
+
+    /**
+     * @brief Re-indexes one model file after it was written or removed.
+     *
+     * The resident copy is dropped; handles still pinning it keep the old
+     * data until they are released, and the next Acquire() parses the file
+     * again.
+     *
+     * @return The model name, or an empty symbol if @p file is not a model file.
+     */
+    Symbol OnFileChanged(const std::filesystem::path &file);
+
+    /** @brief Changes the budget, evicting at once if it shrank. */
+    void SetBudget(size_t budgetBytes);
+
+    Stats GetStats() const;
+
+private:
+    friend class BlockModelHandle;
+
+    /** @brief One model file; never erased, so waiting threads can keep references. */
+    struct Entry
+    {
+        std::filesystem::path file;           ///< Empty once the file was removed.
+        std::shared_ptr<const BlockModel> model;
+        size_t bytes = 0;                     ///< Estimated size of @c model.
+        uint32_t pins = 0;
+        uint32_t generation = 0;              ///< Bumped by every file change; a parse started before it is discarded.
+        bool loading = false;                 ///< A thread is parsing the file.
+        bool failed = false;                  ///< Last parse failed; retried after a file change.
+        bool inLru = false;
+        std::list<Symbol>::iterator lruIt;
+    };
+
+    /** @brief Splits a file name into block and model name; false if it is not a model file. */
+    static bool ParseFileName(const std::filesystem::path &file, std::string &blockName, std::string &modelName);
+
+    /** @brief Adds a pin to a resident entry; caller holds @c mutex_. */
+    BlockModelHandle PinLocked(Symbol name, Entry &entry);
+
+    /** @brief Drops one pin; called by @ref BlockModelHandle. */
+    void Unpin(Symbol name) noexcept;
+
+    /** @brief Frees the resident copy of @p entry; caller holds @c mutex_. */
+    void DropLocked(Entry &entry);
+
+    /** @brief Evicts least recently used models until the budget holds; caller holds @c mutex_. */
+    void EvictLocked();
+
+    ILogger &logger_;
+    std::filesystem::path modelsFolder_;
+    BlockJsonLoader loader_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable loaded_;
+
+    std::unordered_map<Symbol, Entry> entries_;
+    std::unordered_map<std::string, std::vector<Symbol>> blockModels_;
+
+    /** @brief Unpinned resident models, most recently released first. */
+    std::list<Symbol> lru_;
+
+    size_t budget_;
+    Stats stats_;
+};
@@ -6,6 +6,7 @@
 #include <nlohmann/json.hpp>
 
 #include "JsonLoadable.h"
+#include "Symbol.h"
 #include "IDebugPrintable.h"
 #include "DebugHelpers.h"
 
@@ -38,7 +39,8 @@ struct BlockState : public JsonLoadable, public IDebugPrintable
 
     /// @brief Maps a combination of property values to a specific model name.
     /// Example: `"facing=north,waterlogged=false" → "block/dirt_side"`
-    std::unordered_map<std::string, std::string> variants;
+    /// Both sides are interned; the same key or model name in many blocks is stored once.
+    std::unordered_map<Symbol, Symbol> variants;
 
     /**
      * @brief Returns a compact one-line summary of this block state.
@@ -0,0 +1,392 @@
+#include "BlockModelCompiler.h"
+#include "LogMacros.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+
+namespace
+{
+    // Guards against parent cycles that slip past the visited check and
+    // against `#a -> #b -> #a` texture loops.
+    constexpr int MAX_PARENT_DEPTH = 32;
+    constexpr int MAX_TEXTURE_DEPTH = 16;
+
+    // Per-statement budget: a broken resource pack must not flood the log.
+    constexpr uint32_t MODEL_ERRORS_PER_SECOND = 20;
+
+    // Vanilla parents that most block models derive from.
+    constexpr std::pair<const char *, const char *> BUILTIN_MODELS[] = {
+        {"block", R"({})"},
+        {"cube", R"({
+            "parent": "block/block",
+            "elements": [{
+                "from": [0, 0, 0], "to": [16, 16, 16],
+                "faces": {
+                    "down":  {"texture": "#down",  "cullface": "down"},
+                    "up":    {"texture": "#up",    "cullface": "up"},
+                    "north": {"texture": "#north", "cullface": "north"},
+                    "south": {"texture": "#south", "cullface": "south"},
+                    "west":  {"texture": "#west",  "cullface": "west"},
+                    "east":  {"texture": "#east",  "cullface": "east"}
+                }
+            }]
+        })"},
+        {"cube_all", R"({
+            "parent": "block/cube",
+            "textures": {"particle": "#all", "down": "#all", "up": "#all",
+                         "north": "#all", "south": "#all", "west": "#all", "east": "#all"}
+        })"},
+        {"cube_column", R"({
+            "parent": "block/cube",
+            "textures": {"particle": "#side", "down": "#end", "up": "#end",
+                         "north": "#side", "south": "#side", "west": "#side", "east": "#side"}
+        })"},
+        {"cube_bottom_top", R"({
+            "parent": "block/cube",
+            "textures": {"particle": "#side", "down": "#bottom", "up": "#top",
+                         "north": "#side", "south": "#side", "west": "#side", "east": "#side"}
+        })"},
+    };
+
+    using Vec3 = std::array<float, 3>;
+
+    /**
+     * @brief Corners of a face in model units, in order top-left, bottom-left,
+     *        bottom-right, top-right as seen from outside the element.
+     */
+    std::array<Vec3, 4> FaceCorners(BlockFaceDirection face, const Vec3 &from, const Vec3 &to)
+    {
+        const float x0 = from[0], y0 = from[1], z0 = from[2];
+        const float x1 = to[0], y1 = to[1], z1 = to[2];
+
+        switch (face)
+        {
+        case BlockFaceDirection::Down:
+            return {{{x0, y0, z1}, {x0, y0, z0}, {x1, y0, z0}, {x1, y0, z1}}};
+        case BlockFaceDirection::Up:
+            return {{{x0, y1, z0}, {x0, y1, z1}, {x1, y1, z1}, {x1, y1, z0}}};
+        case BlockFaceDirection::North:
+            return {{{x1, y1, z0}, {x1, y0, z0}, {x0, y0, z0}, {x0, y1, z0}}};
+        case BlockFaceDirection::South:
+            return {{{x0, y1, z1}, {x0, y0, z1}, {x1, y0, z1}, {x1, y1, z1}}};
+        case BlockFaceDirection::West:
+            return {{{x0, y1, z0}, {x0, y0, z0}, {x0, y0, z1}, {x0, y1, z1}}};
+        case BlockFaceDirection::East:
+        default:
+            return {{{x1, y1, z1}, {x1, y0, z1}, {x1, y0, z0}, {x1, y1, z0}}};
+        }
+    }
+
+    Vec3 FaceNormal(BlockFaceDirection face)
+    {
+        switch (face)
+        {
+        case BlockFaceDirection::Down:
+            return {0, -1, 0};
+        case BlockFaceDirection::Up:
+            return {0, 1, 0};
+        case BlockFaceDirection::North:
+            return {0, 0, -1};
+        case BlockFaceDirection::South:
+            return {0, 0, 1};
+        case BlockFaceDirection::West:
+            return {-1, 0, 0};
+        case BlockFaceDirection::East:
+        default:
+            return {1, 0, 0};
+        }
+    }
+
+    /**
+     * @brief UV rectangle vanilla derives from the element bounds when a face
+     *        has no explicit "uv".
+     */
+    std::array<float, 4> DefaultUv(BlockFaceDirection face, const Vec3 &from, const Vec3 &to)
+    {
+        switch (face)
+        {
+        case BlockFaceDirection::Down:
+            return {from[0], 16 - to[2], to[0], 16 - from[2]};
+        case BlockFaceDirection::Up:
+            return {from[0], from[2], to[0], to[2]};
+        case BlockFaceDirection::North:
+            return {16 - to[0], 16 - to[1], 16 - from[0], 16 - from[1]};
+        case BlockFaceDirection::South:
+            return {from[0], 16 - to[1], to[0], 16 - from[1]};
+        case BlockFaceDirection::West:
+            return {from[2], 16 - to[1], to[2], 16 - from[1]};
+        case BlockFaceDirection::East:
+        default:
+            return {16 - to[2], 16 - to[1], 16 - from[2], 16 - from[1]};
+        }
+    }
+
+    /** @brief Rotates @p v by @p degrees around @p axis ("x", "y" or "z") through @p origin. */
+    Vec3 Rotate(const Vec3 &v, const std::string &axis, float degrees, const Vec3 &origin)
+    {
+        const float radians = degrees * std::numbers::pi_v<float> / 180.0f;
+        const float c = std::cos(radians);
+        const float s = std::sin(radians);
+
+        int a = 1, b = 2; // "x": rotate y and z
+        if (axis == "y")
+            a = 2, b = 0;
+        else if (axis == "z")
+            a = 0, b = 1;
+        else if (axis != "x")
+            return v;
+
+        Vec3 r = v;
+        const float pa = v[a] - origin[a];
+        const float pb = v[b] - origin[b];
+        r[a] = origin[a] + pa * c - pb * s;
+        r[b] = origin[b] + pa * s + pb * c;
+        return r;
+    }
+}
+
+BlockModelCompiler::BlockModelCompiler(ILogger &logger, const IBlockTextureAtlasBuilder *atlas)
+    : logger_(logger), atlas_(atlas)
+{
+    for (const auto &[name, text] : BUILTIN_MODELS)
+        builtins_.emplace(Symbol(name), json::parse(text).get<BlockModel>());
+}
+
+void BlockModelCompiler::AddModel(std::string_view name, const BlockModel &model)
+{
+    sources_[Symbol(NormalizeModelName(name))] = &model;
+}
+
+void BlockModelCompiler::AddBlock(const BlockJsonData &block)
+{
+    for (const auto &[name, model] : block.models)
+        AddModel(name.View(), model);
+}
+
+const BlockModel *BlockModelCompiler::FindSource(Symbol name) const
+{
+    if (auto it = sources_.find(name); it != sources_.end())
+        return it->second;
+    if (auto it = builtins_.find(name); it != builtins_.end())
+        return &it->second;
+
+    return nullptr;
+}
+
+const std::vector<BlockElement> *BlockModelCompiler::ElementsOf(Symbol name, const BlockModel &model)
+{
+    if (model.isBlockbench)
+    {
+        const auto &elements = std::get<BlockBenchModel>(model.data).elements;
+        return elements.empty() ? nullptr : &elements;
+    }
+
+    auto [it, inserted] = parsedElements_.try_emplace(name);
+    if (inserted)
+    {
+        const json &raw = std::get<DefaultTemplateModel>(model.data).elements;
+        if (raw.is_array())
+        {
+            try
+            {
+                raw.get_to(it->second);
+            }
+            catch (const std::exception &e)
+            {
+                LOG_WARNING_RATE_LIMITED(logger_, LogCategory::Blocks, MODEL_ERRORS_PER_SECOND,
+                                         "Model {}: invalid elements ({})", name, e.what());
+                it->second.clear();
+            }
+        }
+    }
+
+    return it->second.empty() ? nullptr : &it->second;
+}
+
+BlockModelCompiler::ResolvedModel BlockModelCompiler::Resolve(Symbol name)
+{
+    // Child first; textures are applied root first so children override.
+    std::vector<std::pair<Symbol, const BlockModel *>> chain;
+    Symbol current = name;
+
+    for (int depth = 0; depth < MAX_PARENT_DEPTH; ++depth)
+    {
+        const BlockModel *model = FindSource(current);
+        if (!model)
+        {
+            LOG_WARNING_RATE_LIMITED(logger_, LogCategory::Blocks, MODEL_ERRORS_PER_SECOND,
+                                     "Model {}: unknown parent {}", name, current);
+            break;
+        }
+
+        const bool cycle = std::any_of(chain.begin(), chain.end(),
+                                       [&](const auto &link) { return link.second == model; });
+        if (cycle)
+        {
+            LOG_WARNING_RATE_LIMITED(logger_, LogCategory::Blocks, MODEL_ERRORS_PER_SECOND,
+                                     "Model {}: parent cycle at {}", name, current);
+            break;
+        }
+
+        chain.emplace_back(current, model);
+
+        if (model->isBlockbench)
+            break;
+
+        const std::string &parent = std::get<DefaultTemplateModel>(model->data).parent;
+        if (parent.empty())
+            break;
+        current = Symbol(NormalizeModelName(parent));
+    }
+
+    ResolvedModel resolved;
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+    {
+        const BlockModel &model = *it->second;
+        const auto &textures = model.isBlockbench ? std::get<BlockBenchModel>(model.data).textures
+                                                  : std::get<DefaultTemplateModel>(model.data).textures;
+        for (const auto &[key, value] : textures)
+            resolved.textures[key] = value;
+    }
+
+    for (const auto &[linkName, model] : chain)
+    {
+        if (const auto *elements = ElementsOf(linkName, *model))
+        {
+            resolved.elements = elements;
+            break;
+        }
+    }
+
+    return resolved;
+}
+
+Symbol BlockModelCompiler::ResolveTexture(Symbol modelName, const ResolvedModel &resolved, Symbol reference) const
+{
+    Symbol value = reference;
+
+    for (int depth = 0; depth < MAX_TEXTURE_DEPTH; ++depth)
+    {
+        const std::string_view text = value.View();
+        if (text.empty() || text.front() != '#')
+            return value;
+
+        // A variable that was never interned cannot be a texture key.
+        const std::optional<Symbol> variable = Symbol::Find(text.substr(1));
+        auto it = variable ? resolved.textures.find(*variable) : resolved.textures.end();
+        if (it == resolved.textures.end())
+            break;
+        value = it->second;
+    }
+
+    LOG_WARNING_RATE_LIMITED(logger_, LogCategory::Blocks, MODEL_ERRORS_PER_SECOND,
+                             "Model {}: cannot resolve texture {}", modelName, reference);
+    return {};
+}
+
+uint32_t BlockModelCompiler::InternTexture(Symbol texture, CompiledBlockModels &out)
+{
+    auto [it, inserted] = textureIndex_.try_emplace(texture, static_cast<uint32_t>(out.textures.size()));
+    if (inserted)
+        out.textures.push_back(texture.Str());
+    return it->second;
+}
+
+void BlockModelCompiler::EmitElement(Symbol modelName, const ResolvedModel &resolved,
+                                     const BlockElement &element, CompiledBlockModels &out)
+{
+    // Emit in direction order so the output does not depend on map iteration.
+    std::array<const BlockFace *, 6> faces{};
+    for (const auto &[faceName, face] : element.faces)
+    {
+        const BlockFaceDirection direction = ToBlockFaceDirection(faceName);
+        if (direction != BlockFaceDirection::None)
+            faces[static_cast<size_t>(direction)] = &face;
+    }
+
+    const auto &rotation = element.rotation;
+    const bool rotated = rotation.angle != 0.0f;
+
+    for (size_t i = 0; i < faces.size(); ++i)
+    {
+        const BlockFace *face = faces[i];
+        if (!face)
+            continue;
+
+        const auto direction = static_cast<BlockFaceDirection>(i);
+        const Symbol texture = ResolveTexture(modelName, resolved, face->texture);
+        if (texture.Empty())
+            continue;
+
+        // An all-zero "uv" is treated as absent, like vanilla does for a missing one.
+        std::array<float, 4> uv = face->uv;
+        if (uv == std::array<float, 4>{})
+            uv = DefaultUv(direction, element.from, element.to);
+
+        const TextureRegion region = atlas_ ? atlas_->GetTextureRegion(texture.Str()) : TextureRegion{0, 0, 1, 1};
+        auto atlasU = [&](float u) { return region.u0 + (u / 16.0f) * (region.u1 - region.u0); };
+        auto atlasV = [&](float v) { return region.v0 + (v / 16.0f) * (region.v1 - region.v0); };
+        const std::array<float, 2> cornerUv[4] = {
+            {atlasU(uv[0]), atlasV(uv[1])},
+            {atlasU(uv[0]), atlasV(uv[3])},
+            {atlasU(uv[2]), atlasV(uv[3])},
+            {atlasU(uv[2]), atlasV(uv[1])},
+        };
+
+        CompiledQuad quad{};
+        const auto corners = FaceCorners(direction, element.from, element.to);
+        for (size_t c = 0; c < 4; ++c)
+        {
+            const Vec3 p = rotated ? Rotate(corners[c], rotation.axis, rotation.angle, rotation.origin) : corners[c];
+            quad.vertices[c] = {p[0] / 16.0f, p[1] / 16.0f, p[2] / 16.0f, cornerUv[c][0], cornerUv[c][1]};
+        }
+
+        const Vec3 normal = rotated ? Rotate(FaceNormal(direction), rotation.axis, rotation.angle, {})
+                                    : FaceNormal(direction);
+        std::copy(normal.begin(), normal.end(), quad.normal);
+
+        quad.texture = InternTexture(texture, out);
+        quad.face = direction;
+        quad.cullFace = ToBlockFaceDirection(face->cullface);
+        out.quads.push_back(quad);
+    }
+}
+
+CompiledBlockModels BlockModelCompiler::Compile()
+{
+    CompiledBlockModels out;
+    textureIndex_.clear();
+    parsedElements_.clear();
+
+    // Sorted by text so that model indices do not depend on interning order.
+    std::vector<Symbol> names;
+    names.reserve(sources_.size());
+    for (const auto &[name, model] : sources_)
+        names.push_back(name);
+    std::sort(names.begin(), names.end(), [](Symbol a, Symbol b) { return a.View() < b.View(); });
+
+    out.models.reserve(names.size());
+    for (const Symbol name : names)
+    {
+        CompiledModelRange range;
+        range.firstQuad = static_cast<uint32_t>(out.quads.size());
+
+        const ResolvedModel resolved = Resolve(name);
+        if (resolved.elements)
+        {
+            for (const BlockElement &element : *resolved.elements)
+                EmitElement(name, resolved, element, out);
+        }
+
+        range.quadCount = static_cast<uint32_t>(out.quads.size()) - range.firstQuad;
+        out.modelIndex.emplace(name, static_cast<uint32_t>(out.models.size()));
+        out.models.push_back(range);
+    }
+
+    LOG_INFO(logger_, LogCategory::Blocks, "Compiled {} block models into {} quads ({} textures)",
+             out.models.size(), out.quads.size(), out.textures.size());
+
+    return out;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CompiledBlockModel.h"
+#include "BlockJsonData.h"
+#include "IBlockTextureAtlasBuilder.h"
+#include "ILogger.h"
+
+/**
+ * @brief Flattens JSON block models into @ref CompiledBlockModels.
+ *
+ * For every registered model the compiler:
+ * - follows the @c parent chain (child textures override parent ones, the
+ *   nearest model with elements provides the geometry);
+ * - resolves texture variables such as `#side` to the final texture name;
+ * - applies element rotation and emits one @ref CompiledQuad per face with
+ *   positions in block units and UVs mapped into the atlas region;
+ * - records the face's @c cullface direction.
+ *
+ * The vanilla parents `block`, `cube`, `cube_all`, `cube_column` and
+ * `cube_bottom_top` are built in, so packs do not need to ship them; a pack
+ * model with the same name takes precedence.
+ *
+ * Broken models (unknown parent, parent cycle, unresolved texture variable)
+ * are logged and compiled with the faces that could be resolved, so one bad
+ * file never stops the rest from loading.
+ *
+ * @code
+ * BlockModelCompiler compiler(logger, &atlas);
+ * compiler.AddBlock(data);
+ * CompiledBlockModels compiled = compiler.Compile();
+ * for (const CompiledQuad &quad : compiled.GetQuads(*compiled.Find("dirt_v")))
+ *     ...
+ * @endcode
+ */
+class BlockModelCompiler
+{
+public:
+    /**
+     * @param logger Receives model errors.
+     * @param atlas  Provides texture regions; without it UVs stay in 0..1 texture space.
+     */
+    explicit BlockModelCompiler(ILogger &logger, const IBlockTextureAtlasBuilder *atlas = nullptr);
+
+    /** @brief Registers a model under its file name (without extension); @p model must outlive Compile(). */
+    void AddModel(std::string_view name, const BlockModel &model);
+
+    /**
+     * @brief Registers all models of @p block.
+     *
+     * Adds nothing with lazy models; register handles from
+     * @ref BlockJsonDataCache::AcquireModel() with AddModel() instead and keep
+     * them until Compile() returns.
+     */
+    void AddBlock(const BlockJsonData &block);
+
+    /**
+     * @brief Compiles every registered model.
+     *
+     * Built-in parents are only compiled if a registered model refers to them.
+     */
+    CompiledBlockModels Compile();
+
+private:
+    /** @brief A model with its parent chain flattened. */
+    struct ResolvedModel
+    {
+        std::unordered_map<Symbol, Symbol> textures;
+        const std::vector<BlockElement> *elements = nullptr;
+    };
+
+    /** @brief Looks up a registered or built-in model by normalized name; nullptr if unknown. */
+    const BlockModel *FindSource(Symbol name) const;
+
+    /** @brief Walks the parent chain of @p name. */
+    ResolvedModel Resolve(Symbol name);
+
+    /** @brief Returns the parsed elements of a vanilla-style model, parsing them once. */
+    const std::vector<BlockElement> *ElementsOf(Symbol name, const BlockModel &model);
+
+    /** @brief Follows `#variable` references to a texture name; empty if unresolved. */
+    Symbol ResolveTexture(Symbol modelName, const ResolvedModel &resolved, Symbol reference) const;
+
+    /** @brief Appends the quads of one element to @p out. */
+    void EmitElement(Symbol modelName, const ResolvedModel &resolved,
+                     const BlockElement &element, CompiledBlockModels &out);
+
+    /** @brief Returns the texture index of @p texture in @p out, adding it if needed. */
+    uint32_t InternTexture(Symbol texture, CompiledBlockModels &out);
+
+    ILogger &logger_;
+    const IBlockTextureAtlasBuilder *atlas_;
+
+    /** @brief Registered models, keyed by normalized name. */
+    std::unordered_map<Symbol, const BlockModel *> sources_;
+
+    /** @brief Built-in vanilla parents, keyed by normalized name. */
+    std::unordered_map<Symbol, BlockModel> builtins_;
+
+    /** @brief Vanilla `elements` parsed from JSON, keyed by model name. */
+    std::unordered_map<Symbol, std::vector<BlockElement>> parsedElements_;
+
+    /** @brief Texture name → index in the output being compiled. */
+    std::unordered_map<Symbol, uint32_t> textureIndex_;
+};
@@ -0,0 +1,350 @@
+#include "BlockStateTable.h"
+#include "BlockJsonDataCache.h"
+#include "LogMacros.h"
+
+#include <algorithm>
+#include <charconv>
+#include <map>
+
+namespace
+{
+    // Per-statement budget: a broken resource pack must not flood the log.
+    constexpr uint32_t STATE_ERRORS_PER_SECOND = 20;
+
+    bool IsInteger(std::string_view text)
+    {
+        int value = 0;
+        auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return ec == std::errc() && end == text.data() + text.size();
+    }
+
+    /** @brief Sorts values numerically if they are all integers ("level=2" < "level=10"). */
+    void SortValues(std::vector<std::string> &values)
+    {
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+
+        if (std::all_of(values.begin(), values.end(), IsInteger))
+        {
+            std::sort(values.begin(), values.end(),
+                      [](const std::string &a, const std::string &b) { return std::stoi(a) < std::stoi(b); });
+        }
+    }
+
+    /** @brief Splits `"a=1,b=2"` into pairs; an empty key or `"normal"` has none. */
+    bool ParseVariantKey(std::string_view key, std::vector<std::pair<std::string, std::string>> &pairs)
+    {
+        pairs.clear();
+        if (key.empty() || key == "normal")
+            return true;
+
+        while (!key.empty())
+        {
+            const size_t comma = key.find(',');
+            const std::string_view pair = key.substr(0, comma);
+            const size_t equals = pair.find('=');
+            if (equals == std::string_view::npos || equals == 0)
+                return false;
+
+            pairs.emplace_back(pair.substr(0, equals), pair.substr(equals + 1));
+            key = comma == std::string_view::npos ? std::string_view{} : key.substr(comma + 1);
+        }
+        return true;
+    }
+}
+
+BlockStateTable BlockStateTable::Build(const BlockJsonDataCache &cache, const CompiledBlockModels &models,
+                                       ILogger &logger)
+{
+    BlockStateTable table;
+    table.layouts_.resize(cache.GetIdCount());
+
+    for (size_t id = 0; id < cache.GetIdCount(); ++id)
+    {
+        const BlockHotData *hot = cache.GetHot(static_cast<BlockId>(id));
+        if (!hot)
+            continue;
+
+        table.AddBlock(hot->id, std::string(cache.GetName(hot->id)), hot->data->state, models, logger);
+    }
+
+    LOG_INFO(logger, LogCategory::Blocks, "Compiled {} block states for {} blocks",
+             table.stateModels_.size(), table.layouts_.size());
+
+    return table;
+}
+
+void BlockStateTable::AddBlock(BlockId id, const std::string &blockName, const BlockState &state,
+                               const CompiledBlockModels &models, ILogger &logger)
+{
+    // --- Value domains, ordered by property name ---
+    std::map<std::string, std::vector<std::string>> domains;
+    for (const auto &[property, value] : state.properties)
+        domains[property].push_back(value);
+
+    struct Variant
+    {
+        Symbol key;
+        Symbol model;
+        std::vector<std::pair<std::string, std::string>> pairs;
+    };
+    std::vector<Variant> variants;
+    variants.reserve(state.variants.size());
+
+    for (const auto &[key, model] : state.variants)
+    {
+        Variant variant{key, model, {}};
+        if (!ParseVariantKey(key, variant.pairs))
+        {
+            LOG_WARNING_RATE_LIMITED(logger, LogCategory::Blocks, STATE_ERRORS_PER_SECOND,
+                                     "Block {}: cannot parse variant key '{}'", blockName, key);
+            continue;
+        }
+        for (const auto &[property, value] : variant.pairs)
+            domains[property].push_back(value);
+        variants.push_back(std::move(variant));
+    }
+
+    // Deterministic tie-breaking between equally specific variants.
+    std::sort(variants.begin(), variants.end(),
+              [](const Variant &a, const Variant &b) { return a.key.View() < b.key.View(); });
+
+    uint64_t stateCount = 1;
+    for (auto &[property, values] : domains)
+    {
+        SortValues(values);
+        stateCount *= values.size();
+    }
+
+    if (domains.size() > std::numeric_limits<PropertyIndex>::max() || stateCount > MAX_STATES_PER_BLOCK)
+    {
+        LOG_WARNING_RATE_LIMITED(logger, LogCategory::Blocks, STATE_ERRORS_PER_SECOND,
+                                 "Block {}: {} states exceed the limit; only the default state is compiled",
+                                 blockName, stateCount);
+
+        // Collapse every property to its default so the block still renders.
+        for (auto &[property, values] : domains)
+        {
+            auto it = state.properties.find(property);
+            values = {it != state.properties.end() ? it->second : values.front()};
+        }
+        while (domains.size() > std::numeric_limits<PropertyIndex>::max())
+            domains.erase(std::prev(domains.end()));
+        stateCount = 1;
+    }
+
+    // --- Layout ---
+    BlockLayout &layout = layouts_[id];
+    layout.firstState = static_cast<uint32_t>(stateModels_.size());
+    layout.stateCount = static_cast<uint32_t>(stateCount);
+    layout.firstProperty = static_cast<uint32_t>(properties_.size());
+    layout.propertyCount = static_cast<PropertyIndex>(domains.size());
+
+    std::unordered_map<std::string_view, PropertyIndex> propertyIndex;
+    uint32_t stride = 1;
+    for (const auto &[name, values] : domains)
+    {
+        propertyIndex.emplace(name, static_cast<PropertyIndex>(properties_.size() - layout.firstProperty));
+
+        Property property;
+        property.stride = stride;
+        property.valueCount = static_cast<uint32_t>(values.size());
+        property.firstValue = static_cast<uint32_t>(valueNames_.size());
+        properties_.push_back(property);
+        propertyNames_.push_back(name);
+        valueNames_.insert(valueNames_.end(), values.begin(), values.end());
+
+        stride *= property.valueCount;
+    }
+
+    auto valueIndex = [&](PropertyIndex p, std::string_view value) -> std::optional<uint32_t>
+    {
+        const Property &property = properties_[layout.firstProperty + p];
+        const auto begin = valueNames_.begin() + property.firstValue;
+        const auto it = std::find(begin, begin + property.valueCount, value);
+        if (it == begin + property.valueCount)
+            return std::nullopt;
+        return static_cast<uint32_t>(it - begin);
+    };
+
+    for (const auto &[name, value] : state.properties)
+    {
+        auto p = propertyIndex.find(name);
+        if (p == propertyIndex.end())
+            continue;
+        if (auto v = valueIndex(p->second, value))
+            layout.defaultState += *v * properties_[layout.firstProperty + p->second].stride;
+    }
+
+    // --- Variants as (property, value) indices, resolved to models once ---
+    struct CompiledVariant
+    {
+        std::vector<std::pair<PropertyIndex, uint32_t>> pairs;
+        uint32_t model = NO_MODEL;
+    };
+    std::vector<CompiledVariant> compiled;
+    compiled.reserve(variants.size());
+
+    for (const Variant &variant : variants)
+    {
+        CompiledVariant cv;
+        bool usable = true;
+        for (const auto &[name, value] : variant.pairs)
+        {
+            auto p = propertyIndex.find(name);
+            std::optional<uint32_t> v = p != propertyIndex.end() ? valueIndex(p->second, value) : std::nullopt;
+            if (!v)
+            {
+                usable = false; // dropped by the state limit
+                break;
+            }
+            cv.pairs.emplace_back(p->second, *v);
+        }
+        if (!usable)
+            continue;
+
+        if (auto model = models.Find(variant.model))
+        {
+            cv.model = *model;
+        }
+        else
+        {
+            LOG_WARNING_RATE_LIMITED(logger, LogCategory::Blocks, STATE_ERRORS_PER_SECOND,
+                                     "Block {}: variant '{}' refers to unknown model {}",
+                                     blockName, variant.key, variant.model);
+        }
+        compiled.push_back(std::move(cv));
+    }
+
+    // --- State id → model ---
+    stateModels_.resize(stateModels_.size() + layout.stateCount, NO_MODEL);
+    std::vector<uint32_t> values(layout.propertyCount);
+
+    for (uint32_t s = 0; s < layout.stateCount; ++s)
+    {
+        for (PropertyIndex p = 0; p < layout.propertyCount; ++p)
+        {
+            const Property &property = properties_[layout.firstProperty + p];
+            values[p] = (s / property.stride) % property.valueCount;
+        }
+
+        const CompiledVariant *best = nullptr;
+        for (const CompiledVariant &cv : compiled)
+        {
+            const bool matches = std::all_of(cv.pairs.begin(), cv.pairs.end(),
+                                             [&](const auto &pair) { return values[pair.first] == pair.second; });
+            if (matches && (!best || cv.pairs.size() > best->pairs.size()))
+                best = &cv;
+        }
+
+        if (best)
+            stateModels_[layout.firstState + s] = best->model;
+    }
+}
+
+const BlockStateTable::Property *BlockStateTable::GetProperty(BlockId id, PropertyIndex property) const noexcept
+{
+    if (id >= layouts_.size() || property >= layouts_[id].propertyCount)
+        return nullptr;
+    return &properties_[layouts_[id].firstProperty + property];
+}
+
+std::span<const uint32_t> BlockStateTable::GetStateModels(BlockId id) const noexcept
+{
+    if (id >= layouts_.size())
+        return {};
+    return {stateModels_.data() + layouts_[id].firstState, layouts_[id].stateCount};
+}
+
+uint32_t BlockStateTable::GetStateCount(BlockId id) const noexcept
+{
+    return id < layouts_.size() ? layouts_[id].stateCount : 0;
+}
+
+uint32_t BlockStateTable::GetDefaultState(BlockId id) const noexcept
+{
+    return id < layouts_.size() ? layouts_[id].defaultState : 0;
+}
+
+std::optional<BlockStateTable::PropertyIndex> BlockStateTable::FindProperty(BlockId id, std::string_view name) const
+{
+    if (id >= layouts_.size())
+        return std::nullopt;
+
+    const BlockLayout &layout = layouts_[id];
+    for (PropertyIndex p = 0; p < layout.propertyCount; ++p)
+    {
+        if (propertyNames_[layout.firstProperty + p] == name)
+            return p;
+    }
+    return std::nullopt;
+}
+
+std::optional<uint32_t> BlockStateTable::FindValue(BlockId id, PropertyIndex property, std::string_view value) const
+{
+    const Property *p = GetProperty(id, property);
+    if (!p)
+        return std::nullopt;
+
+    for (uint32_t v = 0; v < p->valueCount; ++v)
+    {
+        if (valueNames_[p->firstValue + v] == value)
+            return v;
+    }
+    return std::nullopt;
+}
+
+uint32_t BlockStateTable::GetValue(BlockId id, uint32_t state, PropertyIndex property) const noexcept
+{
+    const Property *p = GetProperty(id, property);
+    return p ? (state / p->stride) % p->valueCount : 0;
+}
+
+uint32_t BlockStateTable::WithValue(BlockId id, uint32_t state, PropertyIndex property, uint32_t value) const noexcept
+{
+    const Property *p = GetProperty(id, property);
+    if (!p || value >= p->valueCount)
+        return state;
+
+    const uint32_t current = (state / p->stride) % p->valueCount;
+    return state - current * p->stride + value * p->stride;
+}
+
+std::optional<uint32_t> BlockStateTable::Encode(BlockId id,
+                                                const std::unordered_map<std::string, std::string> &values) const
+{
+    uint32_t state = GetDefaultState(id);
+
+    for (const auto &[name, value] : values)
+    {
+        auto property = FindProperty(id, name);
+        if (!property)
+            return std::nullopt;
+
+        auto index = FindValue(id, *property, value);
+        if (!index)
+            return std::nullopt;
+
+        state = WithValue(id, state, *property, *index);
+    }
+    return state;
+}
+
+std::string BlockStateTable::Describe(BlockId id, uint32_t state) const
+{
+    std::string key;
+    if (id >= layouts_.size())
+        return key;
+
+    const BlockLayout &layout = layouts_[id];
+    for (PropertyIndex p = 0; p < layout.propertyCount; ++p)
+    {
+        const Property &property = properties_[layout.firstProperty + p];
+        if (!key.empty())
+            key += ',';
+        key += propertyNames_[layout.firstProperty + p];
+        key += '=';
+        key += valueNames_[property.firstValue + (state / property.stride) % property.valueCount];
+    }
+    return key;
+}
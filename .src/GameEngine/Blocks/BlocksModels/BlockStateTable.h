@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "BlockHotData.h"
+#include "CompiledBlockModel.h"
+#include "ILogger.h"
+
+class BlockJsonDataCache;
+struct BlockState;
+
+/**
+ * @brief Compiled @ref BlockState variants: numeric state id → model index.
+ *
+ * Every property of a block gets a small value index. A full combination of
+ * values is packed into one dense state id with mixed-radix arithmetic:
+ *
+ *     state = v0 * stride0 + v1 * stride1 + ...,   stride_i = radix_0 * ... * radix_(i-1)
+ *
+ * where properties are ordered by name and values by their natural order
+ * (numerically if all values are integers). For each state the best
+ * matching variant is resolved once at build time into a
+ * @ref CompiledBlockModels model index, so at runtime the lookup is one
+ * array load instead of building and hashing `"facing=north,..."` keys.
+ *
+ * Value domains are taken from the variant keys plus the default values in
+ * @c BlockState::properties. A variant matches a state if all of its
+ * `property=value` pairs match; the most specific match wins, and an empty
+ * key matches every state.
+ *
+ * @code
+ * const BlockStateTable table = BlockStateTable::Build(cache, compiledModels, logger);
+ * uint32_t state = table.GetDefaultState(id);
+ * uint32_t model = table.GetModel(id, state);
+ * @endcode
+ */
+class BlockStateTable
+{
+public:
+    /** @brief Model index for states without a matching variant or model. */
+    static constexpr uint32_t NO_MODEL = std::numeric_limits<uint32_t>::max();
+
+    /** @brief Upper bound of states per block; larger blocks only get their default state. */
+    static constexpr uint32_t MAX_STATES_PER_BLOCK = 1u << 16;
+
+    /** @brief Index of a property within one block, in name order. */
+    using PropertyIndex = uint8_t;
+
+    /**
+     * @brief Compiles the states of every block in @p cache.
+     *
+     * Problems (unparsable variant keys, unknown models, too many states)
+     * are logged; affected states map to @ref NO_MODEL.
+     */
+    static BlockStateTable Build(const BlockJsonDataCache &cache, const CompiledBlockModels &models, ILogger &logger);
+
+    /**
+     * @brief Returns the compiled model of @p state; @ref NO_MODEL if out of range.
+     *
+     * This is the mesher's hot path: two array loads, no hashing.
+     */
+    uint32_t GetModel(BlockId id, uint32_t state) const noexcept
+    {
+        if (id >= layouts_.size() || state >= layouts_[id].stateCount)
+            return NO_MODEL;
+        return stateModels_[layouts_[id].firstState + state];
+    }
+
+    /** @brief Returns the model indices of all states of @p id, indexed by state id. */
+    std::span<const uint32_t> GetStateModels(BlockId id) const noexcept;
+
+    /** @brief Number of states of @p id (1 for blocks without properties, 0 if unknown). */
+    uint32_t GetStateCount(BlockId id) const noexcept;
+
+    /** @brief State made of the defaults in @c BlockState::properties. */
+    uint32_t GetDefaultState(BlockId id) const noexcept;
+
+    /** @brief Finds a property of @p id by name. */
+    std::optional<PropertyIndex> FindProperty(BlockId id, std::string_view name) const;
+
+    /** @brief Finds a value of a property by name. */
+    std::optional<uint32_t> FindValue(BlockId id, PropertyIndex property, std::string_view value) const;
+
+    /** @brief Value index of @p property in @p state. */
+    uint32_t GetValue(BlockId id, uint32_t state, PropertyIndex property) const noexcept;
+
+    /** @brief Returns @p state with @p property set to value index @p value. */
+    uint32_t WithValue(BlockId id, uint32_t state, PropertyIndex property, uint32_t value) const noexcept;
+
+    /**
+     * @brief Encodes `property → value` pairs into a state id.
+     *
+     * Properties not listed keep their default. Meant for tooling and loading
+     * saved worlds, not for per-block use.
+     *
+     * @return The state, or @c std::nullopt for an unknown property or value.
+     */
+    std::optional<uint32_t> Encode(BlockId id, const std::unordered_map<std::string, std::string> &values) const;
+
+    /** @brief Formats @p state as a variant key, e.g. `"facing=north,wet=false"`. */
+    std::string Describe(BlockId id, uint32_t state) const;
+
+    /** @brief Total number of states over all blocks. */
+    size_t GetTotalStateCount() const noexcept { return stateModels_.size(); }
+
+private:
+    /** @brief Where the states and properties of one block live. */
+    struct BlockLayout
+    {
+        uint32_t firstState = 0;
+        uint32_t stateCount = 0;
+        uint32_t defaultState = 0;
+        uint32_t firstProperty = 0;
+        PropertyIndex propertyCount = 0;
+    };
+
+    /** @brief One property of a block. */
+    struct Property
+    {
+        uint32_t stride = 1;     ///< Product of the radices of earlier properties.
+        uint32_t valueCount = 1; ///< Radix of this property.
+        uint32_t firstValue = 0; ///< Offset into @c valueNames_.
+    };
+
+    /** @brief Compiles one block and appends it to the tables. */
+    void AddBlock(BlockId id, const std::string &blockName, const BlockState &state,
+                  const CompiledBlockModels &models, ILogger &logger);
+
+    const Property *GetProperty(BlockId id, PropertyIndex property) const noexcept;
+
+    // Hot data.
+    std::vector<BlockLayout> layouts_;  ///< Indexed by BlockId.
+    std::vector<Property> properties_;  ///< Grouped by block.
+    std::vector<uint32_t> stateModels_; ///< Grouped by block, indexed by state id.
+
+    // Names, for encoding and debugging.
+    std::vector<std::string> propertyNames_; ///< Parallel to @c properties_.
+    std::vector<std::string> valueNames_;    ///< Referenced by @c Property::firstValue.
+};
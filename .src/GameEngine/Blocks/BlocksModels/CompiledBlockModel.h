@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "Symbol.h"
+
+/**
+ * @brief Axis-aligned face directions of a block cell.
+ *
+ * The order matches the usual neighbour offsets: -Y, +Y, -Z, +Z, -X, +X.
+ */
+enum class BlockFaceDirection : uint8_t
+{
+    Down,
+    Up,
+    North,
+    South,
+    West,
+    East,
+    None ///< Not culled by any neighbour.
+};
+
+/**
+ * @brief Parses a model face name (`"north"`, `"up"`, ...).
+ * @return @c BlockFaceDirection::None for empty or unknown names.
+ */
+inline BlockFaceDirection ToBlockFaceDirection(std::string_view name) noexcept
+{
+    if (name == "down" || name == "bottom")
+        return BlockFaceDirection::Down;
+    if (name == "up" || name == "top")
+        return BlockFaceDirection::Up;
+    if (name == "north")
+        return BlockFaceDirection::North;
+    if (name == "south")
+        return BlockFaceDirection::South;
+    if (name == "west")
+        return BlockFaceDirection::West;
+    if (name == "east")
+        return BlockFaceDirection::East;
+    return BlockFaceDirection::None;
+}
+
+/**
+ * @brief Strips the namespace and `block/` folder from a model reference.
+ *
+ * `"minecraft:block/dirt_v"`, `"block/dirt_v"` and `"dirt_v"` all name the
+ * model file `dirt_v.json`.
+ */
+inline std::string_view NormalizeModelName(std::string_view name) noexcept
+{
+    if (auto colon = name.find(':'); colon != std::string_view::npos)
+        name.remove_prefix(colon + 1);
+    if (name.starts_with("block/"))
+        name.remove_prefix(6);
+    return name;
+}
+
+/**
+ * @brief One corner of a compiled quad.
+ *
+ * Position is in block units (0..1 for a full cube), UV is in atlas space.
+ */
+struct CompiledVertex
+{
+    float x, y, z;
+    float u, v;
+};
+
+/**
+ * @brief A fully resolved model face, ready to be copied into a mesh.
+ *
+ * Parent chains, texture variables, element rotation and atlas placement
+ * are already applied. Vertices are counter-clockwise when seen from the
+ * front, starting at the top-left corner of the texture.
+ */
+struct CompiledQuad
+{
+    CompiledVertex vertices[4];
+    float normal[3];                                        ///< Unit normal after element rotation.
+    uint32_t texture = 0;                                   ///< Index into @ref CompiledBlockModels::textures.
+    BlockFaceDirection face = BlockFaceDirection::None;     ///< Face of the source element.
+    BlockFaceDirection cullFace = BlockFaceDirection::None; ///< Skip when this neighbour is opaque.
+};
+
+static_assert(std::is_trivially_copyable_v<CompiledQuad> && std::is_standard_layout_v<CompiledQuad>,
+              "CompiledQuad must stay a plain POD record");
+
+/**
+ * @brief Range of quads that belong to one compiled model.
+ */
+struct CompiledModelRange
+{
+    uint32_t firstQuad = 0;
+    uint32_t quadCount = 0;
+};
+
+/**
+ * @brief Output of @ref BlockModelCompiler: every model as a slice of one quad array.
+ *
+ * Models are addressed by a dense index; the name map is for load time only.
+ */
+struct CompiledBlockModels
+{
+    std::vector<CompiledQuad> quads;                      ///< All quads, grouped by model.
+    std::vector<CompiledModelRange> models;               ///< Indexed by model index.
+    std::unordered_map<Symbol, uint32_t> modelIndex;      ///< Normalized model name → model index.
+    std::vector<std::string> textures;                    ///< Resolved texture names, by texture index.
+
+    /** @brief Returns the quads of model @p index (empty if out of range). */
+    std::span<const CompiledQuad> GetQuads(uint32_t index) const noexcept
+    {
+        if (index >= models.size())
+            return {};
+        const CompiledModelRange &range = models[index];
+        return {quads.data() + range.firstQuad, range.quadCount};
+    }
+
+    /** @brief Looks up a model by name; accepts `minecraft:` and `block/` prefixes. */
+    std::optional<uint32_t> Find(std::string_view name) const
+    {
+        // A name that was never interned cannot be a model.
+        const std::optional<Symbol> symbol = Symbol::Find(NormalizeModelName(name));
+        if (!symbol)
+            return std::nullopt;
+        if (auto it = modelIndex.find(*symbol); it != modelIndex.end())
+            return it->second;
+        return std::nullopt;
+    }
+};
@@ -0,0 +1,387 @@
+#include "BlockJsonData.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Block JSON parser benchmark: DOM vs SAX.
+//
+// Parses every state, definition and model file once per rep with
+//   DOM: json::parse(text).get<T>()  (the old Options<T> path)
+//   SAX: JsonSaxReader<T>::Parse(text)
+// and reports throughput plus peak heap usage. File contents are read into
+// memory first, so only parsing and conversion are measured. Heap usage is
+// counted by the global operator new/delete below; "peak" is the highest
+// live heap above the pre-parse level while one pass keeps all its results;
+// "overhead" is the part of it not retained by the results, i.e. the parse
+// trees and buffers the parser needed on the way.
+// Without --data a large synthetic resource pack is generated in a temp folder.
+//
+// Usage: JsonParseBenchmark [--data <folder with block_states/ block_definitions/ block_models/>]
+//                           [--files N] [--elements E] [--reps R] [--out report.json]
+
+using Clock = std::chrono::steady_clock;
+using nlohmann::json;
+namespace fs = std::filesystem;
+
+// --- Heap accounting ---------------------------------------------------------
+
+namespace
+{
+    // Every block is prefixed with its size so delete knows what it frees.
+    constexpr size_t HEADER = alignof(std::max_align_t);
+
+    std::atomic<size_t> g_liveBytes{0};
+    std::atomic<size_t> g_peakBytes{0};
+
+    void ResetPeak()
+    {
+        g_peakBytes.store(g_liveBytes.load());
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    void* block = std::malloc(size + HEADER);
+    if (!block)
+        throw std::bad_alloc();
+
+    *static_cast<size_t*>(block) = size;
+    const size_t live = g_liveBytes.fetch_add(size) + size;
+    size_t peak = g_peakBytes.load();
+    while (live > peak && !g_peakBytes.compare_exchange_weak(peak, live))
+    {
+    }
+    return static_cast<char*>(block) + HEADER;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if (!ptr)
+        return;
+
+    void* block = static_cast<char*>(ptr) - HEADER;
+    g_liveBytes.fetch_sub(*static_cast<size_t*>(block));
+    std::free(block);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+// --- Benchmark ----------------------------------------------------------------
+
+namespace
+{
+    struct BenchOptions
+    {
+        std::string dataRoot;
+        size_t files = 3000;
+        int elements = 24;
+        int reps = 5;
+        std::string outPath;
+    };
+
+    struct SourceFile
+    {
+        enum class Kind
+        {
+            State,
+            Definition,
+            Model
+        } kind;
+        std::string text;
+    };
+
+    BenchOptions ParseArgs(int argc, char** argv)
+    {
+        BenchOptions o;
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            if (std::strcmp(argv[i], "--data") == 0)
+                o.dataRoot = argv[i + 1];
+            else if (std::strcmp(argv[i], "--files") == 0)
+                o.files = std::stoull(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--elements") == 0)
+                o.elements = std::stoi(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--reps") == 0)
+                o.reps = std::max(1, std::stoi(argv[i + 1])); // the median needs a sample
+            else if (std::strcmp(argv[i], "--out") == 0)
+                o.outPath = argv[i + 1];
+        }
+        return o;
+    }
+
+    void WriteFile(const fs::path& path, const json& j)
+    {
+        std::ofstream out(path);
+        out << j.dump(2);
+    }
+
+    // Writes `files` blocks with a state, a definition, one Blockbench model
+    // with `elements` elements and one vanilla-style model each.
+    void GeneratePack(const fs::path& root, size_t files, int elements)
+    {
+        fs::remove_all(root);
+        fs::create_directories(root / "block_states");
+        fs::create_directories(root / "block_definitions");
+        fs::create_directories(root / "block_models");
+
+        for (size_t i = 0; i < files; ++i)
+        {
+            const std::string name = "block" + std::to_string(i);
+
+            WriteFile(root / "block_states" / (name + ".json"), {
+                {"properties", {{"facing", "north"}, {"lit", "false"}, {"level", "0"}}},
+                {"variants", {
+                    {"facing=north", "block/" + name},
+                    {"facing=south", "block/" + name},
+                    {"lit=true", "block/" + name + "_cube"},
+                    {"facing=east,lit=false", "block/" + name},
+                }},
+            });
+
+            WriteFile(root / "block_definitions" / (name + ".json"), {
+                {"isTransparent", false}, {"isSolid", true}, {"isOpaque", true}, {"isFullCube", i % 3 != 0},
+            });
+
+            json modelElements = json::array();
+            for (int e = 0; e < elements; ++e)
+            {
+                json faces = json::object();
+                for (const char* face : {"north", "east", "south", "west", "up", "down"})
+                    faces[face] = {{"uv", {0.5 * e, 0, 16, 15.25}}, {"texture", "#" + std::to_string(e % 4)},
+                                   {"cullface", face}};
+
+                modelElements.push_back({
+                    {"name", "cube" + std::to_string(e)},
+                    {"from", {0, 0.25 * e, 0}},
+                    {"to", {16, 0.25 * e + 1.5, 16}},
+                    {"rotation", {{"angle", e % 2 ? 22.5 : 0}, {"axis", "y"}, {"origin", {8, 8, 8}}}},
+                    {"faces", faces},
+                });
+            }
+
+            WriteFile(root / "block_models" / (name + ".json"), {
+                {"credit", "JsonParseBenchmark"},
+                {"format_version", "1.21.6"},
+                {"texture_size", {32, 32}},
+                {"textures", {{"0", "block/" + name}, {"1", "block/" + name + "_top"},
+                              {"2", "block/stone"}, {"3", "block/dirt"}, {"particle", "block/" + name}}},
+                {"elements", modelElements},
+                {"display", {{"gui", {{"rotation", {30, 225, 0}}, {"scale", {0.625, 0.625, 0.625}}}}}},
+            });
+
+            WriteFile(root / "block_models" / (name + "_cube.json"), {
+                {"parent", "block/cube_all"},
+                {"textures", {{"all", "block/" + name}}},
+            });
+        }
+    }
+
+    std::vector<SourceFile> ReadPack(const fs::path& root)
+    {
+        std::vector<SourceFile> files;
+        const std::pair<const char*, SourceFile::Kind> folders[] = {
+            {"block_states", SourceFile::Kind::State},
+            {"block_definitions", SourceFile::Kind::Definition},
+            {"block_models", SourceFile::Kind::Model},
+        };
+
+        for (const auto& [folder, kind] : folders)
+        {
+            for (const auto& entry : fs::directory_iterator(root / folder))
+            {
+                if (!entry.is_regular_file() || entry.path().extension() != ".json")
+                    continue;
+
+                std::ifstream in(entry.path(), std::ios::binary);
+                std::ostringstream text;
+                text << in.rdbuf();
+                files.push_back({kind, text.str()});
+            }
+        }
+        return files;
+    }
+
+    /** @brief Results of one pass, kept alive until the pass is measured. */
+    struct Parsed
+    {
+        std::vector<BlockState> states;
+        std::vector<BlockDefinition> definitions;
+        std::vector<BlockModel> models;
+    };
+
+    template <typename T>
+    T ParseDom(const std::string& text)
+    {
+        return json::parse(text).get<T>();
+    }
+
+    template <typename T>
+    T ParseSax(const std::string& text)
+    {
+        return JsonSaxReader<T>::Parse(text);
+    }
+
+    template <bool Sax>
+    void ParseAll(const std::vector<SourceFile>& files, Parsed& out)
+    {
+        for (const SourceFile& file : files)
+        {
+            switch (file.kind)
+            {
+            case SourceFile::Kind::State:
+                out.states.push_back(Sax ? ParseSax<BlockState>(file.text) : ParseDom<BlockState>(file.text));
+                break;
+            case SourceFile::Kind::Definition:
+                out.definitions.push_back(Sax ? ParseSax<BlockDefinition>(file.text)
+                                              : ParseDom<BlockDefinition>(file.text));
+                break;
+            case SourceFile::Kind::Model:
+                out.models.push_back(Sax ? ParseSax<BlockModel>(file.text) : ParseDom<BlockModel>(file.text));
+                break;
+            }
+        }
+    }
+
+    struct PassResult
+    {
+        double medianMs = 0.0;
+        double minMs = 0.0;
+        double maxMs = 0.0;
+        size_t peakBytes = 0;     ///< Peak live heap above the pre-pass level.
+        size_t retainedBytes = 0; ///< Heap still held by the results after the pass.
+    };
+
+    template <bool Sax>
+    PassResult Run(const std::vector<SourceFile>& files, int reps)
+    {
+        PassResult result;
+        std::vector<double> wall;
+
+        for (int rep = 0; rep < reps; ++rep)
+        {
+            Parsed parsed;
+            parsed.states.reserve(files.size());
+            parsed.definitions.reserve(files.size());
+            parsed.models.reserve(files.size());
+
+            const size_t before = g_liveBytes.load();
+            ResetPeak();
+
+            const auto start = Clock::now();
+            ParseAll<Sax>(files, parsed);
+            wall.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+            result.peakBytes = std::max(result.peakBytes, g_peakBytes.load() - before);
+            result.retainedBytes = g_liveBytes.load() - before;
+        }
+
+        std::sort(wall.begin(), wall.end());
+        result.medianMs = wall[wall.size() / 2];
+        result.minMs = wall.front();
+        result.maxMs = wall.back();
+        return result;
+    }
+
+    json ToJson(const PassResult& r, size_t files, size_t bytes)
+    {
+        return {
+            {"wall_ms_median", r.medianMs},
+            {"wall_ms_min", r.minMs},
+            {"wall_ms_max", r.maxMs},
+            {"mb_per_s", r.medianMs > 0.0 ? bytes / 1e6 / (r.medianMs / 1000.0) : 0.0},
+            {"files_per_s", r.medianMs > 0.0 ? files / (r.medianMs / 1000.0) : 0.0},
+            {"peak_bytes", r.peakBytes},
+            {"retained_bytes", r.retainedBytes},
+            {"overhead_bytes", r.peakBytes - r.retainedBytes},
+        };
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const BenchOptions opts = ParseArgs(argc, argv);
+
+    fs::path root(opts.dataRoot);
+    fs::path generated;
+    if (opts.dataRoot.empty())
+    {
+        generated = fs::temp_directory_path() / "JsonParseBenchmark";
+        std::cerr << "[bench] Generating " << opts.files << " blocks with " << opts.elements
+                  << " elements per model in " << generated.string() << "\n";
+        GeneratePack(generated, opts.files, opts.elements);
+        root = generated;
+    }
+
+    const std::vector<SourceFile> files = ReadPack(root);
+    size_t bytes = 0;
+    for (const SourceFile& file : files)
+        bytes += file.text.size();
+
+    std::cerr << "[bench] " << files.size() << " files, " << bytes / 1024 << " KB\n";
+
+    // Warm-up, and a sanity check that both paths accept the same files.
+    {
+        Parsed dom, sax;
+        ParseAll<false>(files, dom);
+        ParseAll<true>(files, sax);
+        if (dom.models.size() != sax.models.size() || dom.states.size() != sax.states.size())
+        {
+            std::cerr << "[bench] DOM and SAX results differ\n";
+            return 1;
+        }
+    }
+
+    const PassResult dom = Run<false>(files, opts.reps);
+    const PassResult sax = Run<true>(files, opts.reps);
+
+    std::cout << "mode   wall_ms    MB/s   files/s   peak_KB  retained_KB  overhead_KB\n";
+    for (const auto& [name, r] : {std::pair<const char*, const PassResult&>{"dom", dom}, {"sax", sax}})
+    {
+        std::printf("%-4s  %8.1f  %6.1f  %8.0f  %8zu  %11zu  %11zu\n", name, r.medianMs,
+                    bytes / 1e6 / (r.medianMs / 1000.0), files.size() / (r.medianMs / 1000.0),
+                    r.peakBytes / 1024, r.retainedBytes / 1024, (r.peakBytes - r.retainedBytes) / 1024);
+    }
+    std::printf("speedup %.2fx, peak heap %+.1f%%\n", sax.medianMs > 0.0 ? dom.medianMs / sax.medianMs : 0.0,
+                dom.peakBytes > 0 ? 100.0 * (static_cast<double>(sax.peakBytes) / dom.peakBytes - 1.0) : 0.0);
+
+    if (!generated.empty())
+        fs::remove_all(generated);
+
+    if (!opts.outPath.empty())
+    {
+        json report;
+        report["meta"] = {
+            {"files", files.size()},
+            {"bytes", bytes},
+            {"reps", opts.reps},
+            {"data", opts.dataRoot.empty() ? "generated" : opts.dataRoot},
+            {"unix_time", static_cast<int64_t>(std::time(nullptr))},
+        };
+        report["dom"] = ToJson(dom, files.size(), bytes);
+        report["sax"] = ToJson(sax, files.size(), bytes);
+
+        std::ofstream out(opts.outPath);
+        out << report.dump(2) << std::endl;
+        std::cerr << "[bench] Report written to " << opts.outPath << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "MappedLogRing.h"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+// Post-mortem reader for the crash log ring (Logger::EnableCrashRing).
+//
+// Prints the records that are still in the ring, oldest first.
+//
+//   LogRingReader <crash.ring> [--tail N] [--min-level trace|debug|info|warn|error|crit]
+
+namespace
+{
+    bool ParseLevel(const char* name, LogLevel& level)
+    {
+        static const std::pair<const char*, LogLevel> names[] = {
+            {"trace", LogLevel::Trace}, {"debug", LogLevel::Debug}, {"info", LogLevel::Info},
+            {"warn", LogLevel::Warning}, {"error", LogLevel::Error}, {"crit", LogLevel::Critical},
+        };
+        for (const auto& [n, l] : names)
+        {
+            if (std::strcmp(name, n) == 0)
+            {
+                level = l;
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: LogRingReader <crash.ring> [--tail N] [--min-level LEVEL]\n";
+        return 2;
+    }
+
+    size_t tail = 0;
+    LogLevel minLevel = LogLevel::Trace;
+    for (int i = 2; i + 1 < argc; i += 2)
+    {
+        if (std::strcmp(argv[i], "--tail") == 0)
+            tail = std::stoull(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--min-level") == 0 && !ParseLevel(argv[i + 1], minLevel))
+        {
+            std::cerr << "unknown level: " << argv[i + 1] << "\n";
+            return 2;
+        }
+    }
+
+    const auto entries = MappedLogRing::ReadFile(argv[1]);
+    if (entries.empty())
+    {
+        std::cerr << "no records (missing file or not a log ring): " << argv[1] << "\n";
+        return 1;
+    }
+
+    size_t first = 0;
+    if (tail > 0)
+    {
+        // Count backwards so --tail applies after level filtering.
+        size_t kept = 0;
+        for (first = entries.size(); first > 0 && kept < tail; --first)
+        {
+            if (entries[first - 1].level >= minLevel)
+                ++kept;
+        }
+    }
+
+    for (size_t i = first; i < entries.size(); ++i)
+    {
+        if (entries[i].level >= minLevel)
+            std::cout << entries[i].text << '\n';
+    }
+    return 0;
+}
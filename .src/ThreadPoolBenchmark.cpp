@@ -0,0 +1,514 @@
+#include "ThreadPool.h"
+#include "TaskFactory.h"
+#include "TaskCategoryStrategy.h"
+#include "LoadBalanceStrategy.h"
+#include "WorkerIdlePolicy.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// Thread pool microbenchmarks.
+//
+// Every scenario runs against every dispatch strategy and worker idle policy.
+// Results are written as JSON so runs can be diffed across releases.
+//
+// Usage: ThreadPoolBenchmark [--out report.json] [--tasks N] [--reps R] [--workers W]
+
+using Clock = std::chrono::steady_clock;
+using nlohmann::json;
+
+namespace
+{
+    // Fixed seed so skewed/mixed workloads are identical between runs.
+    constexpr uint32_t BENCH_SEED = 0x5EED1234u;
+
+    struct BenchOptions
+    {
+        size_t tasks = 200000;
+        int reps = 3;
+        int workers = -1;
+        std::string outPath;
+    };
+
+    struct StrategyEntry
+    {
+        const char* name;
+        std::function<std::unique_ptr<IDispatchStrategy>()> make;
+    };
+
+    struct Sample
+    {
+        std::vector<uint64_t> latencyNs; // enqueue -> start of execution
+        std::vector<uint64_t> submitNs;  // duration of AddTask()
+        double wallMs = 0.0;
+        double cpuMs = 0.0;
+        size_t executed = 0;
+    };
+
+    inline uint64_t NowNs() noexcept
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+    }
+
+    // Process-wide CPU time (user + kernel) in milliseconds.
+    double ProcessCpuMs()
+    {
+#ifdef _WIN32
+        FILETIME creation, exit, kernel, user;
+        if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+            return 0.0;
+        auto toMs = [](const FILETIME& ft)
+        {
+            ULARGE_INTEGER v;
+            v.LowPart = ft.dwLowDateTime;
+            v.HighPart = ft.dwHighDateTime;
+            return static_cast<double>(v.QuadPart) / 10000.0; // 100ns units
+        };
+        return toMs(kernel) + toMs(user);
+#else
+        rusage ru{};
+        getrusage(RUSAGE_SELF, &ru);
+        auto toMs = [](const timeval& tv)
+        {
+            return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+        };
+        return toMs(ru.ru_utime) + toMs(ru.ru_stime);
+#endif
+    }
+
+    // Burns roughly `ns` nanoseconds of CPU without touching shared memory.
+    void BusyWork(uint64_t ns) noexcept
+    {
+        const uint64_t end = NowNs() + ns;
+        while (NowNs() < end)
+        {
+            _mm_pause();
+        }
+    }
+
+    // Retries on QueueFull so no task is lost; the retry time counts as submit cost.
+    void Submit(ThreadPool& pool, TaskType type, std::unique_ptr<ITask> task)
+    {
+        while (true)
+        {
+            AddTaskResult res = pool.AddTask(type, std::move(task));
+            if (res)
+                return;
+            task = std::move(res.task);
+            std::this_thread::yield();
+        }
+    }
+
+    void WaitUntilZero(const std::atomic<size_t>& remaining)
+    {
+        while (remaining.load(std::memory_order_acquire) != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    json Percentiles(std::vector<uint64_t>& values)
+    {
+        if (values.empty())
+            return json::object();
+
+        std::sort(values.begin(), values.end());
+        auto at = [&](double q)
+        {
+            size_t idx = static_cast<size_t>(q * static_cast<double>(values.size() - 1));
+            return values[idx];
+        };
+
+        return {
+            {"p50", at(0.50)},
+            {"p99", at(0.99)},
+            {"p999", at(0.999)},
+            {"max", values.back()},
+        };
+    }
+
+    // ------------------------------------------------------------------
+    //                          SCENARIOS
+    // ------------------------------------------------------------------
+
+    // Many empty tasks from one producer: pure scheduling overhead.
+    Sample EmptyTaskThroughput(ThreadPool& pool, size_t n)
+    {
+        Sample s;
+        s.latencyNs.assign(n, 0);
+        std::atomic<size_t> remaining{n};
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            const uint64_t enq = NowNs();
+            Submit(pool, TaskType::Light, TaskFactory::MakeTask(
+                [&s, &remaining, i, enq]()
+                {
+                    s.latencyNs[i] = NowNs() - enq;
+                    remaining.fetch_sub(1, std::memory_order_release);
+                }));
+        }
+
+        WaitUntilZero(remaining);
+        s.executed = n;
+        return s;
+    }
+
+    // Cost of AddTask() itself, measured per call.
+    Sample SubmitLatency(ThreadPool& pool, size_t n)
+    {
+        Sample s;
+        s.submitNs.assign(n, 0);
+        std::atomic<size_t> remaining{n};
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            auto task = TaskFactory::MakeTask(
+                [&remaining]()
+                {
+                    remaining.fetch_sub(1, std::memory_order_release);
+                });
+
+            const uint64_t t0 = NowNs();
+            Submit(pool, TaskType::Light, std::move(task));
+            s.submitNs[i] = NowNs() - t0;
+        }
+
+        WaitUntilZero(remaining);
+        s.executed = n;
+        return s;
+    }
+
+    // A root task spawns `width` children; the last child to finish closes the round.
+    // Latency is measured per round: root submit -> last child done.
+    Sample FanOutFanIn(ThreadPool& pool, size_t n)
+    {
+        constexpr size_t width = 64;
+        const size_t rounds = std::max<size_t>(1, n / width);
+
+        Sample s;
+        s.latencyNs.assign(rounds, 0);
+
+        for (size_t r = 0; r < rounds; ++r)
+        {
+            std::atomic<size_t> pending{width};
+            std::atomic<size_t> done{1};
+            const uint64_t start = NowNs();
+
+            Submit(pool, TaskType::Heavy, TaskFactory::MakeTask(
+                [&pool, &pending, &done, &s, r, start]()
+                {
+                    for (size_t c = 0; c < width; ++c)
+                    {
+                        Submit(pool, TaskType::Heavy, TaskFactory::MakeTask(
+                            [&pending, &done, &s, r, start]()
+                            {
+                                if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                                {
+                                    s.latencyNs[r] = NowNs() - start;
+                                    done.store(0, std::memory_order_release);
+                                }
+                            }));
+                    }
+                }));
+
+            WaitUntilZero(done);
+        }
+
+        s.executed = rounds * (width + 1);
+        return s;
+    }
+
+    // 90% tiny tasks, 10% tasks ~100x heavier: exposes poor load balancing.
+    Sample SkewedLoad(ThreadPool& pool, size_t n)
+    {
+        Sample s;
+        s.latencyNs.assign(n, 0);
+        std::atomic<size_t> remaining{n};
+
+        std::mt19937 rng(BENCH_SEED);
+        std::uniform_int_distribution<int> dist(0, 9);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            const uint64_t cost = (dist(rng) == 0) ? 20000 : 200;
+            const uint64_t enq = NowNs();
+            Submit(pool, TaskType::Heavy, TaskFactory::MakeTask(
+                [&s, &remaining, i, enq, cost]()
+                {
+                    s.latencyNs[i] = NowNs() - enq;
+                    BusyWork(cost);
+                    remaining.fetch_sub(1, std::memory_order_release);
+                }));
+        }
+
+        WaitUntilZero(remaining);
+        s.executed = n;
+        return s;
+    }
+
+    // Several producers submitting concurrently: contention on dispatch and queues.
+    Sample ProducerContention(ThreadPool& pool, size_t n)
+    {
+        const size_t producers = std::max<size_t>(2, std::thread::hardware_concurrency() / 2);
+        const size_t perProducer = n / producers;
+        const size_t total = perProducer * producers;
+
+        Sample s;
+        s.latencyNs.assign(total, 0);
+        s.submitNs.assign(total, 0);
+        std::atomic<size_t> remaining{total};
+        std::atomic<bool> go{false};
+
+        std::vector<std::thread> threads;
+        threads.reserve(producers);
+
+        for (size_t p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&, p]()
+            {
+                while (!go.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+
+                for (size_t k = 0; k < perProducer; ++k)
+                {
+                    const size_t i = p * perProducer + k;
+                    const uint64_t enq = NowNs();
+                    Submit(pool, TaskType::Light, TaskFactory::MakeTask(
+                        [&s, &remaining, i, enq]()
+                        {
+                            s.latencyNs[i] = NowNs() - enq;
+                            remaining.fetch_sub(1, std::memory_order_release);
+                        }));
+                    s.submitNs[i] = NowNs() - enq;
+                }
+            });
+        }
+
+        go.store(true, std::memory_order_release);
+        for (auto& t : threads)
+            t.join();
+
+        WaitUntilZero(remaining);
+        s.executed = total;
+        return s;
+    }
+
+    // Realistic mix: 10% IO (blocking), 60% Light, 30% Heavy.
+    Sample MixedTraffic(ThreadPool& pool, size_t n)
+    {
+        Sample s;
+        s.latencyNs.assign(n, 0);
+        std::atomic<size_t> remaining{n};
+
+        std::mt19937 rng(BENCH_SEED);
+        std::uniform_int_distribution<int> dist(0, 99);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            const int roll = dist(rng);
+            const TaskType type =
+                (roll < 10) ? TaskType::IO :
+                (roll < 70) ? TaskType::Light : TaskType::Heavy;
+
+            const uint64_t enq = NowNs();
+            Submit(pool, type, TaskFactory::MakeTask(
+                [&s, &remaining, i, enq, type]()
+                {
+                    s.latencyNs[i] = NowNs() - enq;
+                    switch (type)
+                    {
+                        case TaskType::IO:
+                            std::this_thread::sleep_for(std::chrono::microseconds(50));
+                            break;
+                        case TaskType::Light:
+                            BusyWork(100);
+                            break;
+                        case TaskType::Heavy:
+                            BusyWork(5000);
+                            break;
+                    }
+                    remaining.fetch_sub(1, std::memory_order_release);
+                }));
+        }
+
+        WaitUntilZero(remaining);
+        s.executed = n;
+        return s;
+    }
+
+    struct ScenarioEntry
+    {
+        const char* name;
+        Sample (*run)(ThreadPool&, size_t);
+        size_t divisor; // scales down task count for expensive scenarios
+    };
+
+    Sample Measure(const ScenarioEntry& scenario, ThreadPool& pool, size_t n)
+    {
+        const double cpu0 = ProcessCpuMs();
+        const auto t0 = Clock::now();
+
+        Sample s = scenario.run(pool, n);
+
+        s.wallMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        s.cpuMs = ProcessCpuMs() - cpu0;
+        return s;
+    }
+
+    BenchOptions ParseArgs(int argc, char** argv)
+    {
+        BenchOptions o;
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            if (std::strcmp(argv[i], "--out") == 0)
+                o.outPath = argv[i + 1];
+            else if (std::strcmp(argv[i], "--tasks") == 0)
+                o.tasks = std::stoull(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--reps") == 0)
+                o.reps = std::stoi(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--workers") == 0)
+                o.workers = std::stoi(argv[i + 1]);
+        }
+        return o;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const BenchOptions opts = ParseArgs(argc, argv);
+
+    const std::vector<StrategyEntry> strategies = {
+        {"load_balance", [] { return std::make_unique<LoadBalanceStrategy>(); }},
+        {"task_category", [] { return std::make_unique<TaskCategoryStrategy>(); }},
+    };
+
+    const std::vector<WorkerIdlePolicy> policies = {
+        WorkerIdlePolicy::SpinYieldSleep,
+        WorkerIdlePolicy::YieldSleep,
+        WorkerIdlePolicy::Sleep,
+        WorkerIdlePolicy::BusySpin,
+    };
+
+    const std::vector<ScenarioEntry> scenarios = {
+        {"empty_task_throughput", &EmptyTaskThroughput, 1},
+        {"submit_latency", &SubmitLatency, 1},
+        {"fan_out_fan_in", &FanOutFanIn, 1},
+        {"skewed_load", &SkewedLoad, 20},
+        {"producer_contention", &ProducerContention, 1},
+        {"mixed_traffic", &MixedTraffic, 20},
+    };
+
+    ThreadPool& pool = ThreadPool::Instance();
+    if (opts.workers > 0)
+        pool.SetWorkerCount(opts.workers);
+    pool.SetStrategy(strategies.front().make());
+    pool.Init();
+
+    json report;
+    report["meta"] = {
+        {"hardware_concurrency", std::thread::hardware_concurrency()},
+        {"workers", pool.GetWorkers().size()},
+        {"tasks", opts.tasks},
+        {"reps", opts.reps},
+        {"seed", BENCH_SEED},
+        {"stats_enabled", WORKER_ENABLE_STATS != 0},
+        {"unix_time", static_cast<int64_t>(std::time(nullptr))},
+    };
+    report["results"] = json::array();
+    report["complete"] = false;
+
+    // Rewritten after every row, so a crashing configuration keeps the rows before it.
+    auto save = [&]
+    {
+        if (opts.outPath.empty())
+            return;
+        std::ofstream out(opts.outPath, std::ios::trunc);
+        out << report.dump(2) << std::endl;
+    };
+
+    for (const auto& strategy : strategies)
+    {
+        // TaskCategoryStrategy needs at least one IO, Light and Heavy worker.
+        if (std::strcmp(strategy.name, "task_category") == 0 && pool.GetWorkers().size() < 4)
+        {
+            std::cerr << "[bench] Skipping " << strategy.name << ": needs at least 4 workers\n";
+            continue;
+        }
+
+        pool.SetStrategy(strategy.make());
+
+        for (WorkerIdlePolicy policy : policies)
+        {
+            pool.SetIdlePolicy(policy);
+
+            for (const auto& scenario : scenarios)
+            {
+                const size_t n = std::max<size_t>(1, opts.tasks / scenario.divisor);
+
+                // Warm-up: fault in queues and wake every worker once.
+                Measure(scenario, pool, std::max<size_t>(1, n / 10));
+
+                for (int rep = 0; rep < opts.reps; ++rep)
+                {
+                    Sample s = Measure(scenario, pool, n);
+
+                    json row = {
+                        {"scenario", scenario.name},
+                        {"strategy", strategy.name},
+                        {"idle_policy", ToString(policy)},
+                        {"rep", rep},
+                        {"tasks", s.executed},
+                        {"wall_ms", s.wallMs},
+                        {"cpu_ms", s.cpuMs},
+                        {"tasks_per_sec", s.wallMs > 0.0 ? s.executed * 1000.0 / s.wallMs : 0.0},
+                    };
+                    if (!s.latencyNs.empty())
+                        row["latency_ns"] = Percentiles(s.latencyNs);
+                    if (!s.submitNs.empty())
+                        row["submit_ns"] = Percentiles(s.submitNs);
+
+                    report["results"].push_back(std::move(row));
+                    save();
+                    std::cerr << "[bench] " << strategy.name << " / " << ToString(policy)
+                              << " / " << scenario.name << " rep " << rep << " done\n";
+                }
+            }
+        }
+    }
+
+    pool.SetIdlePolicy(WorkerIdlePolicy::SpinYieldSleep);
+    pool.Shutdown();
+
+    report["complete"] = true;
+    if (opts.outPath.empty())
+    {
+        std::cout << report.dump(2) << std::endl;
+    }
+    else
+    {
+        save();
+        std::cerr << "[bench] Report written to " << opts.outPath << "\n";
+    }
+
+    return 0;
+}
@@ -1,13 +1,17 @@
 #include "GLFWWindow.h"
 #include "Logger.h"
+#include "LogMacros.h"
+#include "MemoryLogSink.h"
 #include "PathProvider.h"
 #include "Options.h"
 #include "BlocksIncluder.h" // Регистрирует все блоки
 #include "BlockJsonDataCache.h"
+#include "BlockModelCompiler.h"
+#include "BlockStateTable.h"
 #include "ImageData.h"
-
-#define STB_IMAGE_WRITE_IMPLEMENTATION
-#include <stbImage/stb_image_write.h>
+#include "ThreadPool.h"
+#include "TaskCategoryStrategy.h"
+#include "LoadBalanceStrategy.h"
 
 int main()
 {
@@ -20,6 +24,25 @@ int main()
     logger.SetLogFile(paths.GetPath(Folders::Logs).string());
     logger.SetLogLevel(LogLevel::Debug);
     logger.SetOutput(LogOutput::Both);
+    logger.FindSink("console")->SetLevel(LogLevel::Info); // quiet console, verbose file
+    logger.EnableRotation();
+    logger.SetStructuredLogFile((paths.GetPath(Folders::Logs) / "structured.jsonl").string());
+    logger.EnableCrashRing((paths.GetPath(Folders::Logs) / "crash.ring").string());
+    logger.EnableAsync();
+
+    // Последние строки лога в памяти: для консоли и для проверок ниже
+    auto memoryLog = std::make_shared<MemoryLogSink>(1024, LogLevel::Trace);
+    logger.AddSink(memoryLog);
+
+    // Пул потоков: JSON блоков загружается параллельно
+    auto &pool = ThreadPool::Instance();
+    pool.Init();
+    // Раздельные очереди IO/Light/Heavy нужны минимум 4 рабочих; иначе балансировка по нагрузке
+    if (pool.GetWorkers().size() >= 4)
+        pool.SetStrategy(std::make_unique<TaskCategoryStrategy>());
+    else
+        pool.SetStrategy(std::make_unique<LoadBalanceStrategy>());
+    pool.SetErrorLogger(&logger);
 
     logger.Info("Creating window...");
 
@@ -128,6 +151,13 @@ int main()
         else
             logger.Error("⚠️ Cache miss — returned a new object for the same block name!");
 
+        // Плотная таблица по BlockType должна указывать на те же данные
+        const BlockHotData *dirtHot = cache.GetHot(BlockType::Dirt);
+        if (dirtHot && dirtHot->data == &dirtDataAgain->get() && !cache.GetHot(BlockType::Air))
+            logger.Info("✅ Dense block table matches the name lookup.");
+        else
+            logger.Error("❌ Dense block table disagrees with the name lookup!");
+
         // Проверим обработку несуществующего блока
         auto unknownData = cache.Get("minecraft:unknown_block");
         if (!unknownData.has_value())
@@ -137,17 +167,68 @@ int main()
 
         // Проверим, что в кеше есть ожидаемое количество элементов
         size_t totalCount = cache.GetLoadedCount();
-        logger.Info("📦 Total loaded blocks in cache: " + std::to_string(totalCount));
+        logger.LogStructured(LogCategory::Blocks, LogLevel::Info, "📦 Block cache loaded",
+                             {{"blocks", totalCount}});
 
         if (totalCount == 0)
             logger.Critical("❌ Cache appears empty — check JSON file paths or parsing errors.");
         else
             logger.Info("✅ Cache contains data. JSON parsing appears successful.");
 
+        // Компилируем модели в плоский массив квадов для меше-билдера
+        BlockModelCompiler modelCompiler(logger);
+        for (size_t id = 0; id < cache.GetIdCount(); ++id)
+        {
+            if (const BlockHotData *hot = cache.GetHot(static_cast<BlockId>(id)))
+                modelCompiler.AddBlock(*hot->data);
+        }
+        const CompiledBlockModels compiledModels = modelCompiler.Compile();
+
+        if (compiledModels.quads.empty())
+            logger.Error("❌ Model compiler produced no quads!");
+        else
+            logger.Info("✅ Block models compiled to flat quads.");
+
+        // Таблица состояний: state id → индекс скомпилированной модели
+        const BlockStateTable stateTable = BlockStateTable::Build(cache, compiledModels, logger);
+        const BlockId dirtId = static_cast<BlockId>(BlockType::Dirt);
+        if (stateTable.GetModel(dirtId, stateTable.GetDefaultState(dirtId)) != BlockStateTable::NO_MODEL)
+            logger.Info("✅ Default dirt state resolves to a compiled model.");
+        else
+            logger.Error("❌ Default dirt state has no compiled model!");
+
+        // Модели доступны и через хэндлы (в ленивом режиме они грузятся при первом запросе)
+        const std::vector<Symbol> dirtModels = cache.GetModelNames("dirt");
+        if (!dirtModels.empty() && cache.AcquireModel(dirtModels.front()))
+            logger.Info("✅ Model handle resolves dirt's first model.");
+        else
+            logger.Error("❌ Dirt has no model reachable through AcquireModel!");
+
         logger.Info("🧩 BlockJsonDataCache test completed successfully.");
 
-        logger.Info(dirtDataAgain.value().get().ToPrettyString());
-        logger.Info(dirtDataAgain.value().get().ToShortString());
+        // Горячая перезагрузка: правки JSON подхватываются без перезапуска
+        cache.Subscribe([&logger](const BlockJsonChange &change)
+        {
+            LOG_INFO(logger, LogCategory::Blocks, "🔁 Block {} reloaded ({} models changed)",
+                     change.blockName, change.changedModels.size());
+        });
+        cache.EnableHotReload();
+
+        // Проверяем лог через MemoryLogSink, а не только по выводу
+        logger.Flush();
+        if (memoryLog->Contains(LogLevel::Info, "Block cache loaded"))
+            logger.Info("✅ Log capture works — cache summary found in memory sink.");
+        else
+            logger.Error("❌ Cache summary missing from memory sink!");
+
+        if (const size_t errors = memoryLog->CountAtLeast(LogLevel::Error); errors == 0)
+            logger.Info("✅ No errors logged during startup tests.");
+        else
+            LOG_WARNING(logger, LogCategory::General, "⚠️ {} error lines logged during startup tests.", errors);
+
+        // Dumps are only built when Json debug output is enabled.
+        LOG_DEBUG(logger, LogCategory::Json, "{}", dirtDataAgain.value().get().ToPrettyString());
+        LOG_DEBUG(logger, LogCategory::Json, "{}", dirtDataAgain.value().get().ToShortString());
     }
     catch (const std::exception &ex)
     {
@@ -169,6 +250,8 @@ int main()
         window.PollEvents();
     }
 
+    BlockJsonDataCache::Instance(logger, paths).DisableHotReload();
+    pool.Shutdown();
     logger.Info("Game shutdown complete.");
     return 0;
 }
\ No newline at end of file